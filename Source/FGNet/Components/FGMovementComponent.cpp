@@ -1,7 +1,9 @@
 #include "FGMovementComponent.h"
 #include "../FGMovementStatics.h"
+#include "../FGNetStats.h"
 #include "GameFramework/Actor.h"
 #include "Engine//World.h"
+#include "Components/PrimitiveComponent.h"
 
 void UFGMovementComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
@@ -22,28 +24,163 @@ FFGFrameMovement UFGMovementComponent::CreateFrameMovement() const
 
 void UFGMovementComponent::Move(FFGFrameMovement& FrameMovement)
 {
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_MovementMove);
+
 	Hit.Reset();
 
+	if (ShouldRevalidateFloor())
+	{
+		FindFloor(CachedFloor);
+		bFloorDirty = false;
+	}
+
 	FVector Delta = GetMovementDelta(FrameMovement);
-	MoveUpdatedComponent(Delta, FacingRotationCurrent, true, &Hit);
 
-	if (Hit.bBlockingHit && FVector::DotProduct(FVector::UpVector, Hit.Normal) > 0.0f)
+	if (IsGrounded())
 	{
+		// While we have a floor the move is planar, the only vertical part is closing the gap found by the last floor check.
 		AccumulatedGravity = 0.0f;
-		Delta = GetMovementDelta(FrameMovement);
+		Delta = FVector::VectorPlaneProject(FrameMovement.GetMovementDelta(), CachedFloor.Normal) - FVector(0.0f, 0.0f, CachedFloor.Distance);
+		CachedFloor.Distance = 0.0f;
 	}
 
-	SlideAlongSurface(Delta, 10.0f - Hit.Time, Hit.Normal, Hit);
+	const FVector OriginalDelta = Delta;
+	FVector PreviousNormal = FVector::ZeroVector;
+	int32 NumIterations = 0;
+	bool bResolved = false;
+
+	while (NumIterations < MaxMoveIterations)
+	{
+		if (Delta.IsNearlyZero())
+		{
+			bResolved = true;
+			break;
+		}
+
+		++NumIterations;
+
+		FHitResult IterationHit;
+		SafeMoveUpdatedComponent(Delta, FacingRotationCurrent, true, IterationHit);
+
+		if (!IterationHit.bBlockingHit)
+		{
+			bResolved = true;
+			break;
+		}
+
+		if (!Hit.bBlockingHit)
+			Hit = IterationHit;
+
+		FVector RemainingDelta = Delta * (1.0f - IterationHit.Time);
+
+		if (FVector::DotProduct(FVector::UpVector, IterationHit.Normal) > 0.0f)
+		{
+			// Landed on something walkable, what is left of this iteration continues along it without its fall.
+			// Hit times are fractions of this iteration's delta, not of the frame's.
+			AccumulatedGravity = 0.0f;
+			SetFloorFromHit(CachedFloor, IterationHit, 0.0f);
+			RemainingDelta = FVector::VectorPlaneProject(FVector(RemainingDelta.X, RemainingDelta.Y, 0.0f), IterationHit.Normal);
+		}
+
+		FVector SlideDelta = FVector::VectorPlaneProject(RemainingDelta, IterationHit.Normal);
+
+		if (!PreviousNormal.IsZero() && FVector::DotProduct(SlideDelta, PreviousNormal) < 0.0f)
+		{
+			// Wedged between two planes, slide along the crease between them.
+			const FVector Crease = FVector::CrossProduct(PreviousNormal, IterationHit.Normal).GetSafeNormal();
+			SlideDelta = Crease * FVector::DotProduct(RemainingDelta, Crease);
+		}
+
+		// Never slide back against where we wanted to go, that is what makes corners jitter.
+		if (FVector::DotProduct(SlideDelta, OriginalDelta) <= 0.0f)
+		{
+			bResolved = true;
+			break;
+		}
+
+		Delta = SlideDelta;
+		PreviousNormal = IterationHit.Normal;
+	}
+
+	INC_DWORD_STAT(STAT_FGNet_Moves);
+	INC_DWORD_STAT_BY(STAT_FGNet_MoveIterations, NumIterations);
+	if (!bResolved)
+	{
+		INC_DWORD_STAT(STAT_FGNet_MovesOutOfIterations);
+	}
 
+	FrameMovement.NumIterations = NumIterations;
 	FrameMovement.Hit = Hit;
 	FrameMovement.FinalLocation = UpdatedComponent->GetComponentLocation();
 }
 
 void UFGMovementComponent::ApplyGravity()
 {
+	if (IsGrounded())
+		return;
+
 	AccumulatedGravity += Gravity * GetWorld()->GetDeltaSeconds();
 }
 
+void UFGMovementComponent::InvalidateFloor()
+{
+	bFloorDirty = true;
+}
+
+bool UFGMovementComponent::ShouldRevalidateFloor() const
+{
+	if (bFloorDirty)
+		return true;
+
+	// While falling the move sweep itself tells us when we land.
+	if (!CachedFloor.bIsWalkable)
+		return false;
+
+	const UPrimitiveComponent* FloorComponent = CachedFloor.Component.Get();
+	if (FloorComponent == nullptr)
+		return true;
+
+	if (!FloorComponent->GetComponentLocation().Equals(CachedFloor.ComponentLocation))
+		return true;
+
+	return FVector::DistSquared(UpdatedComponent->GetComponentLocation(), CachedFloor.CheckLocation) > FMath::Square(FloorRevalidateDistance);
+}
+
+void UFGMovementComponent::FindFloor(FFGFloorResult& OutFloor) const
+{
+	OutFloor.Reset();
+
+	if (UpdatedPrimitive == nullptr)
+		return;
+
+	const FVector Start = UpdatedComponent->GetComponentLocation();
+	const FVector End = Start - FVector(0.0f, 0.0f, FloorCheckDistance);
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(FGFindFloor), false, GetOwner());
+	FCollisionResponseParams ResponseParams;
+	UpdatedPrimitive->InitSweepCollisionParams(QueryParams, ResponseParams);
+
+	FHitResult FloorHit;
+	GetWorld()->SweepSingleByChannel(FloorHit, Start, End, UpdatedComponent->GetComponentQuat(), UpdatedPrimitive->GetCollisionObjectType(), UpdatedPrimitive->GetCollisionShape(), QueryParams, ResponseParams);
+
+	OutFloor.CheckLocation = Start;
+
+	if (FloorHit.bBlockingHit && !FloorHit.bStartPenetrating)
+	{
+		SetFloorFromHit(OutFloor, FloorHit, FloorHit.Distance);
+	}
+}
+
+void UFGMovementComponent::SetFloorFromHit(FFGFloorResult& OutFloor, const FHitResult& FloorHit, float FloorDistance) const
+{
+	OutFloor.Normal = FloorHit.Normal;
+	OutFloor.CheckLocation = UpdatedComponent->GetComponentLocation();
+	OutFloor.Component = FloorHit.Component;
+	OutFloor.ComponentLocation = FloorHit.Component.IsValid() ? FloorHit.Component->GetComponentLocation() : FVector::ZeroVector;
+	OutFloor.Distance = FloorDistance;
+	OutFloor.bIsWalkable = FVector::DotProduct(FVector::UpVector, FloorHit.Normal) > 0.0f;
+}
+
 void UFGMovementComponent::SetFacingRotation(const FRotator& InFacingRotation, float InRotationSpeed)
 {
 	Internal_SetFacingRotation(InFacingRotation, InRotationSpeed);
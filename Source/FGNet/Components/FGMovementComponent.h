@@ -5,6 +5,28 @@
 
 struct FFGFrameMovement;
 
+struct FFGFloorResult
+{
+	void Reset()
+	{
+		Normal = FVector::UpVector;
+		CheckLocation = FVector::ZeroVector;
+		ComponentLocation = FVector::ZeroVector;
+		Component.Reset();
+		Distance = 0.0f;
+		bIsWalkable = false;
+	}
+
+	FVector Normal = FVector::UpVector;
+	// Where the updated component was when the floor was last checked
+	FVector CheckLocation = FVector::ZeroVector;
+	// Where the floor component was when the floor was last checked, used to detect moving floors
+	FVector ComponentLocation = FVector::ZeroVector;
+	TWeakObjectPtr<UPrimitiveComponent> Component;
+	float Distance = 0.0f;
+	bool bIsWalkable = false;
+};
+
 UCLASS()
 class FGNET_API UFGMovementComponent : public UMovementComponent
 {
@@ -21,6 +43,18 @@ public:
 	UPROPERTY(EditAnywhere, Category = Movement)
 	float Gravity = 30.0f;
 
+	// Max number of collide-and-slide iterations for a single move.
+	UPROPERTY(EditAnywhere, Category = Movement, meta = (ClampMin = 1))
+	int32 MaxMoveIterations = 4;
+
+	// How far below the updated component we look for a floor.
+	UPROPERTY(EditAnywhere, Category = "Movement|Floor", meta = (ClampMin = 0.0))
+	float FloorCheckDistance = 10.0f;
+
+	// How far we can move before the cached floor is checked again.
+	UPROPERTY(EditAnywhere, Category = "Movement|Floor", meta = (ClampMin = 0.0))
+	float FloorRevalidateDistance = 25.0f;
+
 	FVector GetGravityAsVector() const { return FVector(0.0F, 0.0F, AccumulatedGravity); }
 	FRotator GetFacingRotation() const { return FacingRotationCurrent; }
 	FVector GetFacingDirection() const { return FacingRotationCurrent.Vector(); }
@@ -29,13 +63,25 @@ public:
 	void SetFacingRotation(const FQuat& InFacingRotation, float InRotationSpeed = -1.0f);
 	void SetFacingDirection(const FVector& InFacingRotation, float InRotationSpeed = -1.0f);
 
+	bool IsGrounded() const { return CachedFloor.bIsWalkable; }
+	const FFGFloorResult& GetCachedFloor() const { return CachedFloor; }
+
+	// Call after teleporting the updated component so the floor is checked on the next move.
+	void InvalidateFloor();
+
 private:
 	void Internal_SetFacingRotation(const FRotator& InFacingRotation, float InRotationSpeed);
 	FVector GetMovementDelta(const FFGFrameMovement& FrameMovement) const;
 
+	bool ShouldRevalidateFloor() const;
+	void FindFloor(FFGFloorResult& OutFloor) const;
+	void SetFloorFromHit(FFGFloorResult& OutFloor, const FHitResult& FloorHit, float FloorDistance) const;
+
 	FHitResult Hit;
+	FFGFloorResult CachedFloor;
 	FRotator FacingRotationCurrent;
 	FRotator FacingRotationTarget;
 	float AccumulatedGravity = 0.0f;
 	float FacingRotationSpeed = 1.0f;
+	bool bFloorDirty = true;
 };
@@ -1,4 +1,5 @@
 #include "FGReplicatorBase.h"
+#include "FGReplicatorTickManager.h"
 #include "GameFramework/Pawn.h"
 #include "Engine/Engine.h"
 #include "Net/UnrealNetwork.h"
@@ -45,19 +46,56 @@ bool UFGReplicatorBase::IsNameStableForNetworking() const
 	return true;
 }
 
-void UFGReplicatorBase::Tick(float DeltaTime) {
-	
+void UFGReplicatorBase::BeginDestroy()
+{
+	SetShouldTick(false);
+
+	Super::BeginDestroy();
 }
-bool UFGReplicatorBase::IsTickable() const {
-	return bShouldTick;
+
+void UFGReplicatorBase::Tick(float DeltaTime)
+{
+	FFGReplicatorCommandBuffer Commands;
+	TickConcurrent(DeltaTime, Commands);
+
+	for (const FFGReplicatorCommand& Command : Commands)
+	{
+		ExecuteCommand(Command);
+	}
+
+	FinishTickConcurrent();
 }
-TStatId UFGReplicatorBase::GetStatId() const {
-	return UObject::GetStatID();
+
+void UFGReplicatorBase::FinishTickConcurrent()
+{
+	bIsLocallyControlledCached = IsLocallyControlled();
+	PostTickConcurrent();
 }
 
 void UFGReplicatorBase::SetShouldTick(bool bInShouldTick)
 {
 	bShouldTick = bInShouldTick;
+
+	if (bShouldTick)
+	{
+		bIsLocallyControlledCached = IsLocallyControlled();
+
+		if (TickListIndex == INDEX_NONE && !HasAnyFlags(RF_ClassDefaultObject))
+		{
+			TickManager = UFGReplicatorTickManager::Get(this);
+			if (TickManager.IsValid())
+				TickManager->RegisterReplicator(this);
+		}
+	}
+	else if (TickListIndex != INDEX_NONE)
+	{
+		if (TickManager.IsValid())
+			TickManager->UnregisterReplicator(this);
+		else
+			TickListIndex = INDEX_NONE;
+
+		TickManager.Reset();
+	}
 }
 
 bool UFGReplicatorBase::IsTicking() const
@@ -1,9 +1,29 @@
 #pragma once
 
 #include "UObject/Object.h"
-#include "Tickable.h"
+#include "../../Tick/FGTickList.h"
 #include "FGReplicatorBase.generated.h"
 
+class UFGReplicatorTickManager;
+class UFGReplicatorBase;
+
+enum class EFGReplicatorCommandType : uint8
+{
+	SendReplicatedValue,
+	SendTerminalValue
+};
+
+// Something a replicator wants done on the game thread, queued while it ticks concurrently.
+struct FFGReplicatorCommand
+{
+	UFGReplicatorBase* Replicator;
+	int32 SyncTag;
+	float Value;
+	EFGReplicatorCommandType Type;
+};
+
+typedef TArray<FFGReplicatorCommand, TInlineAllocator<4>> FFGReplicatorCommandBuffer;
+
 UENUM()
 enum class EFGSmoothReplicatorMode : uint8
 {
@@ -20,7 +40,7 @@ struct TFGSmoothReplicatorOperation
 };
 
 UCLASS(abstract, BlueprintType, Blueprintable)
-class FGNET_API UFGReplicatorBase : public UObject, public FTickableGameObject
+class FGNET_API UFGReplicatorBase : public UObject
 {
 	GENERATED_BODY()
 public:
@@ -31,21 +51,42 @@ public:
 	virtual bool CallRemoteFunction(UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack) override;
 	virtual bool IsSupportedForNetworking() const override;
 	virtual bool IsNameStableForNetworking() const override;
+	virtual void BeginDestroy() override;
 	//UObject
 
-	// FTickableGameObject
-	virtual void Tick(float DeltaTime) override;
-	virtual bool IsTickable() const override;
-	virtual TStatId GetStatId() const override;
-	// FTickableGameObject
+	// Ticks on the game thread, runs TickConcurrent and executes its commands right away.
+	virtual void Tick(float DeltaTime);
 
+	// Can run on a worker thread. Must only touch this replicator, RPCs and other side effects go in OutCommands.
+	virtual void TickConcurrent(float DeltaTime, FFGReplicatorCommandBuffer& OutCommands) {}
+
+	// Game thread, for every command queued by TickConcurrent.
+	virtual void ExecuteCommand(const FFGReplicatorCommand& Command) {}
+
+	// Game thread, after this frame's commands have been executed.
+	void FinishTickConcurrent();
+
+	// Awake replicators are registered with the world's UFGReplicatorTickManager, sleeping ones cost nothing per frame.
 	void SetShouldTick(bool bInShouldTick);
 	bool IsTicking() const;
 
 	bool IsLocallyControlled() const;
 	bool HasAuthority() const;
 
+protected:
+	virtual void PostTickConcurrent() {}
+
+	// IsLocallyControlled as of the last game thread update, for use in TickConcurrent.
+	bool IsLocallyControlledCached() const { return bIsLocallyControlledCached; }
+
 private:
+	template <typename ElementType>
+	friend class TFGTickList;
+
+	int32 TickListIndex = INDEX_NONE;
+
+	TWeakObjectPtr<UFGReplicatorTickManager> TickManager;
 
 	bool bShouldTick = false;
-};
\ No newline at end of file
+	bool bIsLocallyControlledCached = false;
+};
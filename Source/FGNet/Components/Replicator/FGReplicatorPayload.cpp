@@ -0,0 +1,92 @@
+#include "FGReplicatorPayload.h"
+
+int32 FFGReplicatorPayload::GetSequenceDelta(uint32 A, uint32 B)
+{
+	const int32 Delta = static_cast<int32>((A - B) & SequenceMask);
+	return Delta > static_cast<int32>(SequenceMask >> 1) ? Delta - static_cast<int32>(SequenceMask + 1) : Delta;
+}
+
+bool FFGReplicatorPayload::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	uint32 SequenceValue = Sequence;
+	Ar.SerializeInt(SequenceValue, SequenceMask + 1);
+
+	uint8 bQuantized = IsQuantized() ? 1 : 0;
+	Ar.SerializeBits(&bQuantized, 1);
+
+	if (bQuantized)
+	{
+		// Bit count is sent as 0-15 for 1-16 bits, so the payload decodes the same wherever it sits in the archive.
+		uint32 NumBitsValue = NumQuantizedBits - 1;
+		Ar.SerializeInt(NumBitsValue, MaxQuantizedBits);
+
+		const uint32 NumBits = NumBitsValue + 1;
+		uint32 Value = QuantizedValue;
+		Ar.SerializeInt(Value, 1 << NumBits);
+
+		if (Ar.IsLoading())
+		{
+			NumQuantizedBits = static_cast<uint8>(NumBits);
+			QuantizedValue = Value;
+		}
+	}
+	else
+	{
+		Ar << RawValue;
+
+		if (Ar.IsLoading())
+		{
+			NumQuantizedBits = 0;
+		}
+	}
+
+	if (Ar.IsLoading())
+	{
+		Sequence = static_cast<uint16>(SequenceValue);
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+uint32 FFGReplicatorQuantization::GetNumBits() const
+{
+	if (!bEnabled || Max <= Min || Precision <= 0.0f)
+		return 0;
+
+	const float NumSteps = FMath::RoundToFloat((Max - Min) / Precision);
+	if (NumSteps >= static_cast<float>(1 << FFGReplicatorPayload::MaxQuantizedBits))
+		return 0;
+
+	return FMath::Max(FMath::CeilLogTwo(static_cast<uint32>(NumSteps) + 1), 1u);
+}
+
+FFGReplicatorPayload FFGReplicatorQuantization::MakePayload(int32 SyncTag, float Value) const
+{
+	FFGReplicatorPayload Payload;
+	Payload.Sequence = static_cast<uint16>(SyncTag & FFGReplicatorPayload::SequenceMask);
+
+	const uint32 NumBits = GetNumBits();
+	if (NumBits > 0)
+	{
+		const uint32 MaxQuantizedValue = (1u << NumBits) - 1;
+		const float Step = FMath::RoundToFloat((FMath::Clamp(Value, Min, Max) - Min) / Precision);
+
+		Payload.NumQuantizedBits = static_cast<uint8>(NumBits);
+		Payload.QuantizedValue = FMath::Min(static_cast<uint32>(Step), MaxQuantizedValue);
+	}
+	else
+	{
+		Payload.RawValue = Value;
+	}
+
+	return Payload;
+}
+
+float FFGReplicatorQuantization::GetValue(const FFGReplicatorPayload& Payload) const
+{
+	if (!Payload.IsQuantized())
+		return Payload.RawValue;
+
+	return FMath::Min(Min + static_cast<float>(Payload.QuantizedValue) * Precision, Max);
+}
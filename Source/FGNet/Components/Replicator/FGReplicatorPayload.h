@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FGReplicatorPayload.generated.h"
+
+/*
+ * One replicator update on the wire: a wrapping 12 bit sequence number followed by the value, either quantized to
+ * at most 16 bits or as a raw float. A 0-100 value at 0.1 precision is 27 bits instead of 64.
+ */
+USTRUCT()
+struct FGNET_API FFGReplicatorPayload
+{
+	GENERATED_BODY()
+
+	static constexpr uint32 SequenceBits = 12;
+	static constexpr uint32 SequenceMask = (1 << SequenceBits) - 1;
+	static constexpr uint32 MaxQuantizedBits = 16;
+
+	// Signed distance from B to A. Wrap-safe as long as the two are less than half the sequence range apart.
+	static int32 GetSequenceDelta(uint32 A, uint32 B);
+	static bool IsSequenceNewer(uint32 A, uint32 B) { return GetSequenceDelta(A, B) > 0; }
+
+	bool IsQuantized() const { return NumQuantizedBits > 0; }
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	// Reflected so RPCs don't skip the parameter as identical to its default.
+	UPROPERTY()
+	uint16 Sequence = 0;
+	// 0 means the value is sent as RawValue.
+	UPROPERTY()
+	uint8 NumQuantizedBits = 0;
+	UPROPERTY()
+	uint32 QuantizedValue = 0;
+	UPROPERTY()
+	float RawValue = 0.0f;
+};
+
+template<>
+struct TStructOpsTypeTraits<FFGReplicatorPayload> : public TStructOpsTypeTraitsBase2<FFGReplicatorPayload>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+// Value range and precision of a replicator. Both ends use their own copy, so it has to match on every machine.
+USTRUCT(BlueprintType)
+struct FGNET_API FFGReplicatorQuantization
+{
+	GENERATED_BODY()
+
+	// Values outside the range are clamped. Ranges that need more than 16 bits at this precision are sent as raw floats.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Quantization)
+	bool bEnabled = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Quantization, meta = (EditCondition = "bEnabled"))
+	float Min = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Quantization, meta = (EditCondition = "bEnabled"))
+	float Max = 100.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Quantization, meta = (EditCondition = "bEnabled", ClampMin = 0.0001))
+	float Precision = 0.1f;
+
+	// 0 if values are sent unquantized.
+	uint32 GetNumBits() const;
+
+	FFGReplicatorPayload MakePayload(int32 SyncTag, float Value) const;
+	float GetValue(const FFGReplicatorPayload& Payload) const;
+};
@@ -0,0 +1,126 @@
+#include "FGReplicatorTickManager.h"
+#include "FGReplicatorBase.h"
+#include "Engine/World.h"
+#include "../../FGNetStats.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+
+static TAutoConsoleVariable<int32> CVarReplicatorParallelTick(
+	TEXT("FGNet.Replicator.ParallelTick"),
+	1,
+	TEXT("Tick awake replicators on worker threads."));
+
+static TAutoConsoleVariable<int32> CVarReplicatorParallelTickMinBatch(
+	TEXT("FGNet.Replicator.ParallelTickMinBatch"),
+	128,
+	TEXT("Smallest number of awake replicators before ticking goes wide."));
+
+void UFGReplicatorTickManager::Deinitialize()
+{
+	AwakeReplicators.Empty();
+
+	Super::Deinitialize();
+}
+
+UFGReplicatorTickManager* UFGReplicatorTickManager::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject != nullptr ? WorldContextObject->GetWorld() : nullptr;
+	return World != nullptr ? World->GetSubsystem<UFGReplicatorTickManager>() : nullptr;
+}
+
+void UFGReplicatorTickManager::RegisterReplicator(UFGReplicatorBase* Replicator)
+{
+	AwakeReplicators.Add(Replicator);
+}
+
+void UFGReplicatorTickManager::UnregisterReplicator(UFGReplicatorBase* Replicator)
+{
+	AwakeReplicators.Remove(Replicator);
+}
+
+void UFGReplicatorTickManager::Tick(float DeltaTime)
+{
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_ReplicatorTickManager);
+
+	SET_DWORD_STAT(STAT_FGNet_AwakeReplicators, AwakeReplicators.Num());
+
+	const bool bParallel = CVarReplicatorParallelTick.GetValueOnGameThread() != 0
+		&& AwakeReplicators.Num() >= CVarReplicatorParallelTickMinBatch.GetValueOnGameThread()
+		&& FApp::ShouldUseThreadingForPerformance();
+
+	if (bParallel)
+	{
+		TickParallel(DeltaTime);
+	}
+	else
+	{
+		AwakeReplicators.ForEach([DeltaTime](UFGReplicatorBase& Replicator) { Replicator.Tick(DeltaTime); });
+	}
+}
+
+void UFGReplicatorTickManager::TickParallel(float DeltaTime)
+{
+	AwakeReplicators.BeginIteration();
+
+	const int32 NumReplicators = AwakeReplicators.Num();
+	const int32 NumBatches = FMath::Clamp(FTaskGraphInterface::Get().GetNumWorkerThreads() + 1, 1, NumReplicators);
+	const int32 BatchSize = FMath::DivideAndRoundUp(NumReplicators, NumBatches);
+
+	CommandBuffers.SetNum(NumBatches, false);
+
+	{
+		TArrayView<UFGReplicatorBase* const> Replicators = AwakeReplicators.GetElements();
+		ParallelFor(NumBatches, [this, Replicators, DeltaTime, BatchSize, NumReplicators](int32 BatchIndex)
+		{
+			FFGReplicatorCommandBuffer& Commands = CommandBuffers[BatchIndex];
+			Commands.Reset();
+
+			const int32 End = FMath::Min((BatchIndex + 1) * BatchSize, NumReplicators);
+			for (int32 Index = BatchIndex * BatchSize; Index < End; ++Index)
+			{
+				if (UFGReplicatorBase* Replicator = Replicators[Index])
+					Replicator->TickConcurrent(DeltaTime, Commands);
+			}
+		});
+	}
+
+	for (const FFGReplicatorCommandBuffer& Commands : CommandBuffers)
+	{
+		for (const FFGReplicatorCommand& Command : Commands)
+		{
+			Command.Replicator->ExecuteCommand(Command);
+		}
+	}
+
+	// Executing commands can wake other replicators and grow the list, so look the elements up again.
+	TArrayView<UFGReplicatorBase* const> Replicators = AwakeReplicators.GetElements();
+	for (int32 Index = 0; Index < NumReplicators; ++Index)
+	{
+		if (UFGReplicatorBase* Replicator = Replicators[Index])
+			Replicator->FinishTickConcurrent();
+	}
+
+	AwakeReplicators.EndIteration();
+}
+
+bool UFGReplicatorTickManager::IsTickable() const
+{
+	return AwakeReplicators.Num() > 0;
+}
+
+ETickableTickType UFGReplicatorTickManager::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+UWorld* UFGReplicatorTickManager::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+TStatId UFGReplicatorTickManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFGReplicatorTickManager, STATGROUP_Tickables);
+}
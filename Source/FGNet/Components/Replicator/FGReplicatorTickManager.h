@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "../../Tick/FGTickList.h"
+#include "FGReplicatorBase.h"
+#include "FGReplicatorTickManager.generated.h"
+
+/*
+ * Ticks awake replicators from one dense array. Replicators register when they wake up and unregister when they
+ * go to sleep, so the engine only ever asks this manager whether it wants to tick.
+ * Large batches tick concurrently on worker threads, the commands they queue are executed on the game thread afterwards.
+ */
+UCLASS()
+class FGNET_API UFGReplicatorTickManager : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+
+	static UFGReplicatorTickManager* Get(const UObject* WorldContextObject);
+
+	void RegisterReplicator(UFGReplicatorBase* Replicator);
+	void UnregisterReplicator(UFGReplicatorBase* Replicator);
+
+	int32 GetNumAwakeReplicators() const { return AwakeReplicators.Num(); }
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+	// FTickableGameObject
+
+private:
+	void TickParallel(float DeltaTime);
+
+	TFGTickList<UFGReplicatorBase> AwakeReplicators;
+
+	// One command buffer per batch so workers never share one.
+	TArray<FFGReplicatorCommandBuffer> CommandBuffers;
+};
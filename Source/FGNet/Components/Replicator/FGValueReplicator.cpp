@@ -1,14 +1,19 @@
 #include "FGValueReplicator.h"
 #include "Net/UnrealNetwork.h"
+#include "GameFramework/Actor.h"
+#include "../../FGNetTrace.h"
+#include "../../Debug/FGFlightRecorder.h"
 
-void UFGValueReplicator::Tick(float DeltaTime)
+void UFGValueReplicator::TickConcurrent(float DeltaTime, FFGReplicatorCommandBuffer& OutCommands)
 {
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_ReplicatorTick);
+
 	const float CrumbDuration = (1.0f / static_cast<float>(NumberOfReplicationsPerSecond));
 
-	if (IsLocallyControlled())
+	if (IsLocallyControlledCached())
 	{
 		bool bIsTerminal = false;
-		if (ReplicatedValueCurrent != ReplicatedValuePreviouslySent)
+		if (!IsWithinDeadband(ReplicatedValueCurrent, ReplicatedValuePreviouslySent))
 		{
 			StaticValueTimer = 0.0f;
 		}
@@ -22,17 +27,40 @@ void UFGValueReplicator::Tick(float DeltaTime)
 		SyncTimer -= DeltaTime;
 		if (SyncTimer <= 0.0f)
 		{
+			// Sync tags advance every interval even when nothing is sent, so remotes know how far apart two sends were.
+			const int32 SyncTag = NextSyncTag++;
+
 			if (bIsTerminal)
 			{
 				if (!bHasSentTerminalValue)
 				{
-					Server_SendTerminalValue(NextSyncTag++, ReplicatedValueCurrent);
+					OutCommands.Add({ this, SyncTag, ReplicatedValueCurrent, EFGReplicatorCommandType::SendTerminalValue });
 					bHasSentTerminalValue = true;
+
+					LastSentValue = ReplicatedValueCurrent;
+					LastSentVelocity = 0.0f;
+					LastSentSyncTag = SyncTag;
 				}
 			}
 			else
 			{
-				Server_SendReplicatedValue(NextSyncTag++, ReplicatedValueCurrent);
+				float PredictedValue = LastSentValue;
+				if (SendMode == EFGReplicatorSendMode::ErrorBounded)
+				{
+					PredictedValue = ExtrapolateValue(LastSentValue, LastSentVelocity, static_cast<float>(SyncTag - LastSentSyncTag) * CrumbDuration);
+				}
+
+				// Right after waking up the remotes are sitting on the terminal value and need a fresh one either way.
+				// Long before the wire sequence wraps past half its range a correct prediction is sent anyway, or remotes would drop the next send as old.
+				if (bHasSentTerminalValue || !IsWithinDeadband(ReplicatedValueCurrent, PredictedValue) || SyncTag - LastSentSyncTag >= MaxSyncTagsWithoutSend)
+				{
+					OutCommands.Add({ this, SyncTag, ReplicatedValueCurrent, EFGReplicatorCommandType::SendReplicatedValue });
+
+					LastSentVelocity = bHasSentTerminalValue ? 0.0f : CalculateVelocity(LastSentValue, ReplicatedValueCurrent, SyncTag - LastSentSyncTag);
+					LastSentValue = ReplicatedValueCurrent;
+					LastSentSyncTag = SyncTag;
+				}
+
 				bHasSentTerminalValue = false;
 			}
 
@@ -72,15 +100,15 @@ void UFGValueReplicator::Tick(float DeltaTime)
 
 				if (CurrentCrumbTimeRemaining <= 0.001f)
 				{
-					FrameTarget = CrumbTrail[0].Value;
+					FrameTarget = CrumbTrail.Front().Value;
 					FrameTargetFuture = 0.0f;
 
-					CrumbTrail.RemoveAt(0);
+					CrumbTrail.PopFront();
 					CurrentCrumbTimeRemaining = CrumbDuration;
 				}
 				else
 				{
-					FrameTarget = CrumbTrail[0].Value;
+					FrameTarget = CrumbTrail.Front().Value;
 					FrameTargetFuture = CrumbSize - ConsumeLerp;
 				}
 			}
@@ -104,8 +132,93 @@ void UFGValueReplicator::Tick(float DeltaTime)
 				}
 			}
 		}
+		else if (SendMode == EFGReplicatorSendMode::ErrorBounded && !bHasReceivedTerminalValue && ExtrapolationTime < MaxExtrapolationTime)
+		{
+			// The sender only sends when our extrapolation would be off, so keep going along the last slope.
+			const float ExtrapolationStep = FMath::Min(DeltaTime, MaxExtrapolationTime - ExtrapolationTime);
+			ExtrapolationTime += ExtrapolationStep;
+			ReplicatedValueCurrent += ReceivedVelocity * ExtrapolationStep;
+		}
+	}
+}
+
+void UFGValueReplicator::ExecuteCommand(const FFGReplicatorCommand& Command)
+{
+	// A terminal value must arrive, so it is never replaced by a later unreliable one before it is sent.
+	if (bHasPendingSend && PendingSend.Type == EFGReplicatorCommandType::SendTerminalValue && Command.Type != EFGReplicatorCommandType::SendTerminalValue)
+	{
+		ExecuteScheduledSend();
 	}
 
+	PendingSend = Command;
+	bHasPendingSend = true;
+
+	UFGSendScheduler* SendScheduler = UFGSendScheduler::Get(this);
+	if (SendScheduler == nullptr)
+	{
+		ExecuteScheduledSend();
+		return;
+	}
+
+	// Only a client's uplink is budgeted, on the server the Server RPCs run locally.
+	const AActor* OwnerActor = CastChecked<AActor>(GetOuter());
+	SendScheduler->RequestSend(this, OwnerActor->HasAuthority() ? nullptr : OwnerActor->GetNetConnection());
+}
+
+void UFGValueReplicator::BeginDestroy()
+{
+	if (bHasPendingSend)
+	{
+		if (UFGSendScheduler* SendScheduler = UFGSendScheduler::Get(this))
+			SendScheduler->CancelSend(this);
+
+		bHasPendingSend = false;
+	}
+
+	Super::BeginDestroy();
+}
+
+float UFGValueReplicator::GetSendImportance() const
+{
+	// Terminal values end the remote trail, getting them out late leaves remotes extrapolating.
+	return PendingSend.Type == EFGReplicatorCommandType::SendTerminalValue ? SendImportance * 2.0f : SendImportance;
+}
+
+FVector UFGValueReplicator::GetSendLocation() const
+{
+	const AActor* OwnerActor = Cast<AActor>(GetOuter());
+	return OwnerActor != nullptr ? OwnerActor->GetActorLocation() : FVector::ZeroVector;
+}
+
+int32 UFGValueReplicator::GetEstimatedSendBytes() const
+{
+	// RPC header plus the payload, see FFGReplicatorPayload::NetSerialize.
+	const uint32 NumValueBits = Quantization.GetNumBits() > 0 ? 4 + Quantization.GetNumBits() : 32;
+	return 8 + static_cast<int32>((FFGReplicatorPayload::SequenceBits + 1 + NumValueBits + 7) / 8);
+}
+
+void UFGValueReplicator::ExecuteScheduledSend()
+{
+	if (!bHasPendingSend)
+		return;
+
+	bHasPendingSend = false;
+
+	FGNET_TRACE_NET_SEND(this, GetEstimatedSendBytes());
+
+	switch (PendingSend.Type)
+	{
+	case EFGReplicatorCommandType::SendReplicatedValue:
+		Server_SendReplicatedValue(Quantization.MakePayload(PendingSend.SyncTag, PendingSend.Value));
+		break;
+	case EFGReplicatorCommandType::SendTerminalValue:
+		Server_SendTerminalValue(Quantization.MakePayload(PendingSend.SyncTag, PendingSend.Value));
+		break;
+	}
+}
+
+void UFGValueReplicator::PostTickConcurrent()
+{
 	if (!ShouldTick())
 	{
 		SetShouldTick(false);
@@ -128,12 +241,14 @@ void UFGValueReplicator::SetValue(float InValue)
 	if (!IsLocallyControlled())
 		return;
 
-	if (bIsSleeping)
+	// Jitter inside the deadband of what remotes already hold is kept locally, waking up would only resend the terminal value.
+	if (bIsSleeping && !IsWithinDeadband(InValue, LastSentValue))
 	{
 		ReplicatedValueCurrent = InValue;
 		SetShouldTick(true);
 		bIsSleeping = false;
 		bHasSentTerminalValue = false;
+		StaticValueTimer = 0.0f;
 		SyncTimer = 0.0f;
 	}
 	else
@@ -155,72 +270,123 @@ void UFGValueReplicator::BroadcastDelegate()
 		OnValueChanged.Broadcast();
 }
 
-void UFGValueReplicator::Server_SendTerminalValue_Implementation(int32 SyncTag, float TerminalValue)
+void UFGValueReplicator::Server_SendTerminalValue_Implementation(const FFGReplicatorPayload& Payload)
 {
-	if (SyncTag < LastReceivedSyncTag)
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_ReplicatorValueRPC);
+
+	if (IsOlderThanLastReceived(Payload))
 		return;
 
-	LastReceivedSyncTag = SyncTag;
+	LastReceivedSyncTag = Payload.Sequence;
 
-	Multicast_SendTerminalValue(SyncTag, TerminalValue);
+	Multicast_SendTerminalValue(Payload);
 }
 
-void UFGValueReplicator::Server_SendReplicatedValue_Implementation(int32 SyncTag, float ReplicatedValue)
+void UFGValueReplicator::Server_SendReplicatedValue_Implementation(const FFGReplicatorPayload& Payload)
 {
-	if (SyncTag < LastReceivedSyncTag)
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_ReplicatorValueRPC);
+
+	if (IsOlderThanLastReceived(Payload))
 		return;
 
-	LastReceivedSyncTag = SyncTag;
+	LastReceivedSyncTag = Payload.Sequence;
 
-	Multicast_SendReplicatedValue(SyncTag, ReplicatedValue);
+	Multicast_SendReplicatedValue(Payload);
 }
 
-void UFGValueReplicator::Multicast_SendTerminalValue_Implementation(int32 SyncTag, float TerminalValue)
+void UFGValueReplicator::Multicast_SendTerminalValue_Implementation(const FFGReplicatorPayload& Payload)
 {
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_ReplicatorValueRPC);
+
 	if (IsLocallyControlled())
 		return;
 
-	if (!HasAuthority() && SyncTag < LastReceivedSyncTag)
+	if (!HasAuthority() && IsOlderThanLastReceived(Payload))
 		return;
 
-	LastReceivedSyncTag = SyncTag;
+	const float TerminalValue = Quantization.GetValue(Payload);
+
+	LastReceivedSyncTag = Payload.Sequence;
 	bHasReceivedTerminalValue = true;
 
-	auto& Crumb = CrumbTrail.Emplace_GetRef();
-	Crumb.Value = TerminalValue;
+	ReceiveValue(Payload.Sequence, TerminalValue, true);
+
+	CrumbTrail.Push(FCrumb{ TerminalValue });
 
 	SetShouldTick(true);
 }
 
-void UFGValueReplicator::Multicast_SendReplicatedValue_Implementation(int32 SyncTag, float ReplicatedValue)
+void UFGValueReplicator::Multicast_SendReplicatedValue_Implementation(const FFGReplicatorPayload& Payload)
 {
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_ReplicatorValueRPC);
+
 	if (IsLocallyControlled())
 		return;
 
-	if (!HasAuthority() && SyncTag < LastReceivedSyncTag)
+	if (!HasAuthority() && IsOlderThanLastReceived(Payload))
 		return;
 
+	const float ReplicatedValue = Quantization.GetValue(Payload);
+
 	if (bHasReceivedTerminalValue)
 	{
 		if (CrumbTrail.Num() == 0)
 		{
-			auto& WaitCrumb = CrumbTrail.Emplace_GetRef();
-			WaitCrumb.Value = ReplicatedValueCurrent;
+			CrumbTrail.Push(FCrumb{ ReplicatedValueCurrent });
 		}
 	}
 
-	LastReceivedSyncTag = SyncTag;
+	ReceiveValue(Payload.Sequence, ReplicatedValue, bHasReceivedTerminalValue);
+
+	LastReceivedSyncTag = Payload.Sequence;
 	bHasReceivedTerminalValue = false;
 
-	auto& Crumb = CrumbTrail.Emplace_GetRef();
-	Crumb.Value = ReplicatedValue;
+	// Pushing onto a full trail drops the oldest crumb, the check below keeps it to two seconds of crumbs.
+	CrumbTrail.Push(FCrumb{ ReplicatedValue });
+
+	// Blueprints can set the rate past the clamp, never trim later than the buffer would drop on its own.
+	if (CrumbTrail.Num() >= FMath::Min(NumberOfReplicationsPerSecond, MaxReplicationsPerSecond) * 2)
+		CrumbTrail.PopFront();
 
-	if (CrumbTrail.Num() >= NumberOfReplicationsPerSecond * 2)
-		CrumbTrail.RemoveAt(0, 1, false);
+	UFGFlightRecorder::RecordCrumbTrailDepth(this, CrumbTrail.Num());
 
 	SetShouldTick(true);
 }
 
+bool UFGValueReplicator::IsOlderThanLastReceived(const FFGReplicatorPayload& Payload) const
+{
+	return LastReceivedSyncTag >= 0 && FFGReplicatorPayload::IsSequenceNewer(static_cast<uint32>(LastReceivedSyncTag), Payload.Sequence);
+}
+
+void UFGValueReplicator::ReceiveValue(int32 SyncTag, float Value, bool bResetVelocity)
+{
+	// Same slope the sender predicts us with, see TickConcurrent.
+	ReceivedVelocity = bResetVelocity || LastReceivedCrumbSyncTag < 0 ? 0.0f : CalculateVelocity(LastReceivedValue, Value, FFGReplicatorPayload::GetSequenceDelta(SyncTag, LastReceivedCrumbSyncTag));
+	LastReceivedValue = Value;
+	LastReceivedCrumbSyncTag = SyncTag;
+	ExtrapolationTime = 0.0f;
+}
+
+bool UFGValueReplicator::IsWithinDeadband(float Value, float Reference) const
+{
+	const float Deadband = DeadbandAbsolute + DeadbandRelative * FMath::Abs(Reference);
+	return FMath::Abs(Value - Reference) <= Deadband;
+}
+
+float UFGValueReplicator::CalculateVelocity(float FromValue, float ToValue, int32 SyncTagDelta) const
+{
+	if (SyncTagDelta <= 0)
+		return 0.0f;
+
+	const float CrumbDuration = (1.0f / static_cast<float>(NumberOfReplicationsPerSecond));
+	return (ToValue - FromValue) / (static_cast<float>(SyncTagDelta) * CrumbDuration);
+}
+
+float UFGValueReplicator::ExtrapolateValue(float Value, float Velocity, float Time) const
+{
+	return Value + Velocity * FMath::Min(Time, MaxExtrapolationTime);
+}
+
 bool UFGValueReplicator::ShouldTick() const
 {
 	if (IsLocallyControlled())
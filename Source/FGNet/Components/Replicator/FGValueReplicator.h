@@ -1,29 +1,50 @@
 
 #include "FGReplicatorBase.h"
+#include "FGReplicatorPayload.h"
+#include "../../Containers/FGRingBuffer.h"
+#include "../../Net/FGSendScheduler.h"
 #include "FGValueReplicator.generated.h"
 
+UENUM()
+enum class EFGReplicatorSendMode : uint8
+{
+	// Send whenever the value moved outside the deadband of the last sent value.
+	OnChange,
+	// Send only when the value moved outside the deadband of what remotes extrapolate from the last two sends.
+	ErrorBounded
+};
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FFGOnSmoothValueReplicationChanged);
 
 UCLASS()
-class FGNET_API UFGValueReplicator : public UFGReplicatorBase
+class FGNET_API UFGValueReplicator : public UFGReplicatorBase, public IFGScheduledSender
 {
 	GENERATED_BODY()
 public:
-	virtual void Tick(float DeltaTime) override;
+	virtual void TickConcurrent(float DeltaTime, FFGReplicatorCommandBuffer& OutCommands) override;
+	virtual void ExecuteCommand(const FFGReplicatorCommand& Command) override;
 
 	virtual void Init() override;
+	virtual void BeginDestroy() override;
+
+	// IFGScheduledSender
+	virtual float GetSendImportance() const override;
+	virtual FVector GetSendLocation() const override;
+	virtual int32 GetEstimatedSendBytes() const override;
+	virtual void ExecuteScheduledSend() override;
+	// IFGScheduledSender
 
 	UFUNCTION(Server, Reliable)
-		void Server_SendTerminalValue(int32 SyncTag, float TerminalValue);
+		void Server_SendTerminalValue(const FFGReplicatorPayload& Payload);
 
 	UFUNCTION(Server, Unreliable)
-		void Server_SendReplicatedValue(int32 SyncTag, float ReplicatedValue);
+		void Server_SendReplicatedValue(const FFGReplicatorPayload& Payload);
 
 	UFUNCTION(NetMulticast, Reliable)
-		void Multicast_SendTerminalValue(int32 SyncTag, float TerminalValue);
+		void Multicast_SendTerminalValue(const FFGReplicatorPayload& Payload);
 
 	UFUNCTION(NetMulticast, Unreliable)
-		void Multicast_SendReplicatedValue(int32 SyncTag, float ReplicatedValue);
+		void Multicast_SendReplicatedValue(const FFGReplicatorPayload& Payload);
 
 	UFUNCTION(BlueprintCallable, Category = Network)
 		void SetValue(float InValue);
@@ -31,25 +52,69 @@ public:
 	UFUNCTION(BlueprintPure, Category = Network)
 		float GetValue() const;
 
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 1))
+	// At most MaxReplicationsPerSecond, the crumb trail holds two seconds of it.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 1, ClampMax = 16))
 		int32 NumberOfReplicationsPerSecond = 5;
 
+	static constexpr int32 MaxReplicationsPerSecond = 16;
+
+	// Relative to other scheduled sends when the connection is out of bandwidth.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 0.0))
+		float SendImportance = 1.0f;
+
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 		EFGSmoothReplicatorMode SmoothMode = EFGSmoothReplicatorMode::ConstantVelocity;
 
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		FFGReplicatorQuantization Quantization;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		EFGReplicatorSendMode SendMode = EFGReplicatorSendMode::OnChange;
+
+	// Changes smaller than this are not sent and do not keep the replicator awake.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 0.0))
+		float DeadbandAbsolute = 0.0f;
+
+	// Added to DeadbandAbsolute as a fraction of the value.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 0.0, ClampMax = 1.0))
+		float DeadbandRelative = 0.0f;
+
+	// ErrorBounded only, how long remotes keep extrapolating after the last received value.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 0.0))
+		float MaxExtrapolationTime = 1.0f;
+
 	UPROPERTY(BlueprintAssignable)
 		FFGOnSmoothValueReplicationChanged OnValueChanged;
 
 	bool ShouldTick() const;
+
+protected:
+	virtual void PostTickConcurrent() override;
+
 private:
 	void BroadcastDelegate();
 
+	bool IsWithinDeadband(float Value, float Reference) const;
+
+	// Slope between two sends SyncTagDelta sync intervals apart, what remotes extrapolate with.
+	float CalculateVelocity(float FromValue, float ToValue, int32 SyncTagDelta) const;
+	float ExtrapolateValue(float Value, float Velocity, float Time) const;
+
+	void ReceiveValue(int32 SyncTag, float Value, bool bResetVelocity);
+
+	// Wrap-safe, LastReceivedSyncTag holds the 12 bit wire sequence.
+	bool IsOlderThanLastReceived(const FFGReplicatorPayload& Payload) const;
+
 	struct FCrumb
 	{
 		float Value;
 	};
 
-	TArray<FCrumb, TInlineAllocator<10>> CrumbTrail;
+	TFGRingBuffer<FCrumb, MaxReplicationsPerSecond * 2> CrumbTrail;
+
+	// Newest send waiting for the send scheduler, older ones are superseded by it.
+	FFGReplicatorCommand PendingSend;
+	bool bHasPendingSend = false;
 
 	float ReplicatedValueTarget = 0.0f;
 	float ReplicatedValueCurrent = 0.0f;
@@ -57,10 +122,23 @@ private:
 	float StaticValueTimer = 0.0f;
 	float SleepAfterDuration = 1.0f;
 
+	// A quarter of the wire sequence range, see FFGReplicatorPayload::GetSequenceDelta.
+	static constexpr int32 MaxSyncTagsWithoutSend = 1 << (FFGReplicatorPayload::SequenceBits - 2);
+
 	int32 NextSyncTag = 0;
+	// Wire sequences, -1 until something was received.
 	int32 LastReceivedSyncTag = -1;
 	int32 LastReceivedCrumbSyncTag = -1;
 
+	// What remotes last received from us, mirrors the receiving state below.
+	float LastSentValue = 0.0f;
+	float LastSentVelocity = 0.0f;
+	int32 LastSentSyncTag = -1;
+
+	float LastReceivedValue = 0.0f;
+	float ReceivedVelocity = 0.0f;
+	float ExtrapolationTime = 0.0f;
+
 	float SyncTimer = 0.f;
 	float LerpSpeed = 1.f;
 	float CurrentCrumbTimeRemaining = 0.f;
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+ * Fixed capacity queue for histories and trails, O(1) push and pop and no allocations.
+ * Capacity has to be a power of two. Pushing onto a full buffer drops the oldest element.
+ * Index 0 is the oldest element and Num() - 1 the newest.
+ */
+template <typename ElementType, uint32 Capacity>
+class TFGRingBuffer
+{
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "TFGRingBuffer capacity must be a power of two.");
+
+public:
+	// Returns true if the oldest element was dropped to make room.
+	bool Push(const ElementType& Element)
+	{
+		bool bDropped = false;
+		Push_GetRef(bDropped) = Element;
+		return bDropped;
+	}
+
+	ElementType& Push_GetRef()
+	{
+		bool bDropped = false;
+		return Push_GetRef(bDropped);
+	}
+
+	ElementType& Push_GetRef(bool& bOutDropped)
+	{
+		bOutDropped = IsFull();
+
+		if (bOutDropped)
+			Head = (Head + 1) & Mask;
+		else
+			Count++;
+
+		return Elements[(Head + Count - 1) & Mask];
+	}
+
+	void PopFront()
+	{
+		check(Count > 0);
+		Head = (Head + 1) & Mask;
+		Count--;
+	}
+
+	void PopFront(int32 NumToPop)
+	{
+		check(NumToPop >= 0 && static_cast<uint32>(NumToPop) <= Count);
+		Head = (Head + NumToPop) & Mask;
+		Count -= NumToPop;
+	}
+
+	void PopBack()
+	{
+		check(Count > 0);
+		Count--;
+	}
+
+	ElementType& Front() { check(Count > 0); return Elements[Head]; }
+	const ElementType& Front() const { check(Count > 0); return Elements[Head]; }
+
+	ElementType& Back() { check(Count > 0); return Elements[(Head + Count - 1) & Mask]; }
+	const ElementType& Back() const { check(Count > 0); return Elements[(Head + Count - 1) & Mask]; }
+
+	ElementType& operator[](int32 Index) { checkSlow(static_cast<uint32>(Index) < Count); return Elements[(Head + Index) & Mask]; }
+	const ElementType& operator[](int32 Index) const { checkSlow(static_cast<uint32>(Index) < Count); return Elements[(Head + Index) & Mask]; }
+
+	int32 Num() const { return static_cast<int32>(Count); }
+	static constexpr int32 Max() { return static_cast<int32>(Capacity); }
+	bool IsEmpty() const { return Count == 0; }
+	bool IsFull() const { return Count == Capacity; }
+
+	void Reset()
+	{
+		Head = 0;
+		Count = 0;
+	}
+
+	template <typename BufferType, typename ReferenceType>
+	class TIterator
+	{
+	public:
+		TIterator(BufferType& InBuffer, int32 InIndex) : Buffer(InBuffer), Index(InIndex) {}
+
+		ReferenceType operator*() const { return Buffer[Index]; }
+		TIterator& operator++() { ++Index; return *this; }
+		bool operator!=(const TIterator& Other) const { return Index != Other.Index; }
+
+	private:
+		BufferType& Buffer;
+		int32 Index;
+	};
+
+	using FIterator = TIterator<TFGRingBuffer, ElementType&>;
+	using FConstIterator = TIterator<const TFGRingBuffer, const ElementType&>;
+
+	FIterator begin() { return FIterator(*this, 0); }
+	FIterator end() { return FIterator(*this, Num()); }
+	FConstIterator begin() const { return FConstIterator(*this, 0); }
+	FConstIterator end() const { return FConstIterator(*this, Num()); }
+
+private:
+	static constexpr uint32 Mask = Capacity - 1;
+
+	ElementType Elements[Capacity];
+	uint32 Head = 0;
+	uint32 Count = 0;
+};
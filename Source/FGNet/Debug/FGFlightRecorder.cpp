@@ -0,0 +1,155 @@
+#include "FGFlightRecorder.h"
+#include "Async/Async.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "../FGNet.h"
+
+static TAutoConsoleVariable<int32> CVarFlightRecorderEnabled(
+	TEXT("FGNet.FlightRecorder.Enabled"),
+	1,
+	TEXT("Record the last frames of frame and net stats and dump them on hitches."));
+
+static TAutoConsoleVariable<float> CVarFlightRecorderHitchMs(
+	TEXT("FGNet.FlightRecorder.HitchMs"),
+	100.0f,
+	TEXT("Frames longer than this dump the flight recorder. 0 disables."));
+
+static TAutoConsoleVariable<float> CVarFlightRecorderCorrectionDistance(
+	TEXT("FGNet.FlightRecorder.CorrectionDistance"),
+	200.0f,
+	TEXT("Corrections larger than this dump the flight recorder. 0 disables."));
+
+static TAutoConsoleVariable<float> CVarFlightRecorderMinDumpInterval(
+	TEXT("FGNet.FlightRecorder.MinDumpInterval"),
+	10.0f,
+	TEXT("Seconds between automatic dumps, so a bad stretch writes one file instead of one per frame."));
+
+static FAutoConsoleCommandWithWorld FlightRecorderDumpCommand(
+	TEXT("FGNet.FlightRecorder.Dump"),
+	TEXT("Writes the flight recorder to Saved/FlightRecorder."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UFGFlightRecorder* FlightRecorder = UFGFlightRecorder::Get(World))
+			FlightRecorder->Dump(TEXT("Manual"));
+	}));
+
+UFGFlightRecorder* UFGFlightRecorder::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject != nullptr ? WorldContextObject->GetWorld() : nullptr;
+	return World != nullptr ? World->GetSubsystem<UFGFlightRecorder>() : nullptr;
+}
+
+void UFGFlightRecorder::RecordCorrection(const UObject* WorldContextObject, float Distance)
+{
+	if (UFGFlightRecorder* FlightRecorder = Get(WorldContextObject))
+	{
+		FlightRecorder->FrameNumCorrections++;
+		FlightRecorder->FrameMaxCorrection = FMath::Max(FlightRecorder->FrameMaxCorrection, Distance);
+	}
+}
+
+void UFGFlightRecorder::RecordCrumbTrailDepth(const UObject* WorldContextObject, int32 Depth)
+{
+	if (UFGFlightRecorder* FlightRecorder = Get(WorldContextObject))
+	{
+		FlightRecorder->FrameMaxCrumbTrail = FMath::Max(FlightRecorder->FrameMaxCrumbTrail, static_cast<uint16>(FMath::Min(Depth, static_cast<int32>(MAX_uint16))));
+	}
+}
+
+void UFGFlightRecorder::Tick(float DeltaTime)
+{
+	FFGFlightRecorderFrame& Frame = Frames.Push_GetRef();
+	Frame.Time = FApp::GetCurrentTime();
+	Frame.FrameMs = static_cast<float>(FApp::GetDeltaTime() * 1000.0);
+	Frame.GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	Frame.MaxCorrection = FrameMaxCorrection;
+	Frame.NumCorrections = FrameNumCorrections;
+	Frame.MaxCrumbTrail = FrameMaxCrumbTrail;
+	Frame.Padding = 0;
+
+	const UFGTickManager* TickManager = UFGTickManager::Get(this);
+	for (int32 Phase = 0; Phase < static_cast<int32>(EFGTickPhase::Num); ++Phase)
+	{
+		Frame.PhaseMs[Phase] = TickManager != nullptr ? FPlatformTime::ToMilliseconds(TickManager->GetPhaseCycles(static_cast<EFGTickPhase>(Phase))) : 0.0f;
+	}
+	Frame.NumActiveRockets = TickManager != nullptr ? static_cast<uint16>(FMath::Min(TickManager->GetNumRockets(), static_cast<int32>(MAX_uint16))) : 0;
+
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	const uint32 InTotalPackets = NetDriver != nullptr ? NetDriver->InTotalPackets : 0;
+	const uint32 OutTotalPackets = NetDriver != nullptr ? NetDriver->OutTotalPackets : 0;
+	Frame.PacketsIn = InTotalPackets - LastInTotalPackets;
+	Frame.PacketsOut = OutTotalPackets - LastOutTotalPackets;
+	LastInTotalPackets = InTotalPackets;
+	LastOutTotalPackets = OutTotalPackets;
+
+	FrameMaxCorrection = 0.0f;
+	FrameNumCorrections = 0;
+	FrameMaxCrumbTrail = 0;
+
+	const float HitchMs = CVarFlightRecorderHitchMs.GetValueOnGameThread();
+	const float CorrectionDistance = CVarFlightRecorderCorrectionDistance.GetValueOnGameThread();
+	const bool bHitch = HitchMs > 0.0f && Frame.FrameMs > HitchMs;
+	const bool bCorrection = CorrectionDistance > 0.0f && Frame.MaxCorrection > CorrectionDistance;
+
+	if ((bHitch || bCorrection) && (LastDumpTime < 0.0 || Frame.Time - LastDumpTime > CVarFlightRecorderMinDumpInterval.GetValueOnGameThread()))
+	{
+		Dump(bHitch ? TEXT("Hitch") : TEXT("Correction"));
+	}
+}
+
+void UFGFlightRecorder::Dump(const TCHAR* Reason)
+{
+	if (Frames.Num() == 0)
+		return;
+
+	LastDumpTime = FApp::GetCurrentTime();
+
+	// The copy is the only game thread cost, formatting and writing happen on a worker.
+	TArray<uint8> Data;
+	const uint32 NumRecordedFrames = static_cast<uint32>(Frames.Num());
+	const uint32 FrameSize = sizeof(FFGFlightRecorderFrame);
+	Data.Reserve(16 + NumRecordedFrames * FrameSize);
+
+	const uint32 Header[] = { 0x52464746 /* FGFR */, FileVersion, FrameSize, NumRecordedFrames };
+	Data.Append(reinterpret_cast<const uint8*>(Header), sizeof(Header));
+	for (const FFGFlightRecorderFrame& Frame : Frames)
+	{
+		Data.Append(reinterpret_cast<const uint8*>(&Frame), FrameSize);
+	}
+
+	const FString FileName = FPaths::ProjectSavedDir() / TEXT("FlightRecorder") / FString::Printf(TEXT("FGNet-%s-%s.fgfr"), Reason, *FDateTime::Now().ToString());
+	UE_LOG(LogFGNet, Warning, TEXT("Flight recorder: %s, writing %u frames to %s"), Reason, NumRecordedFrames, *FileName);
+
+	Async(EAsyncExecution::ThreadPool, [Data = MoveTemp(Data), FileName]()
+	{
+		if (!FFileHelper::SaveArrayToFile(Data, *FileName))
+		{
+			UE_LOG(LogFGNet, Warning, TEXT("Flight recorder: could not write %s"), *FileName);
+		}
+	});
+}
+
+bool UFGFlightRecorder::IsTickable() const
+{
+	return CVarFlightRecorderEnabled.GetValueOnGameThread() != 0;
+}
+
+ETickableTickType UFGFlightRecorder::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+UWorld* UFGFlightRecorder::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+TStatId UFGFlightRecorder::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFGFlightRecorder, STATGROUP_Tickables);
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "../Containers/FGRingBuffer.h"
+#include "../Tick/FGTickManager.h"
+#include "FGFlightRecorder.generated.h"
+
+// One recorded frame, written to dumps as is so keep it plain data.
+struct FFGFlightRecorderFrame
+{
+	double Time;
+	float FrameMs;
+	float GameThreadMs;
+	float PhaseMs[static_cast<int32>(EFGTickPhase::Num)];
+	float MaxCorrection;
+	uint32 PacketsIn;
+	uint32 PacketsOut;
+	uint16 NumCorrections;
+	uint16 MaxCrumbTrail;
+	uint16 NumActiveRockets;
+	uint16 Padding;
+};
+
+/*
+ * Keeps the last 512 frames of frame time, tick phase times, packets, corrections, crumb trail depth and rocket count.
+ * A frame over FGNet.FlightRecorder.HitchMs or a correction over FGNet.FlightRecorder.CorrectionDistance writes
+ * the buffer to Saved/FlightRecorder on a background thread. FGNet.FlightRecorder.Dump writes it on demand.
+ */
+UCLASS()
+class FGNET_API UFGFlightRecorder : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	static constexpr uint32 NumFrames = 512;
+	static constexpr uint32 FileVersion = 1;
+
+	static UFGFlightRecorder* Get(const UObject* WorldContextObject);
+
+	// Safe to call with any world context, does nothing without a recorder.
+	static void RecordCorrection(const UObject* WorldContextObject, float Distance);
+	static void RecordCrumbTrailDepth(const UObject* WorldContextObject, int32 Depth);
+
+	void Dump(const TCHAR* Reason);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+	// FTickableGameObject
+
+private:
+	TFGRingBuffer<FFGFlightRecorderFrame, NumFrames> Frames;
+
+	// Accumulated until the end of the frame.
+	float FrameMaxCorrection = 0.0f;
+	uint16 FrameNumCorrections = 0;
+	uint16 FrameMaxCrumbTrail = 0;
+
+	uint32 LastInTotalPackets = 0;
+	uint32 LastOutTotalPackets = 0;
+	double LastDumpTime = -1.0;
+};
@@ -0,0 +1,533 @@
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "../FGNet.h"
+#include "../FGMovementStatics.h"
+#include "../Player/FGPlayer.h"
+#include "../Components/FGMovementComponent.h"
+#include "../Components/Replicator/FGValueReplicator.h"
+
+/*
+ * Netcode microbenchmarks. Run them headless in a standalone game so the RPCs they trigger stay local, for example:
+ * UE4Editor FGNet.uproject Map_Net -game -nullrhi -unattended -ExecCmds="FGNet.Bench -json=Bench.json -baseline=Baseline.json -exit"
+ * Every result is lower-is-better. With -baseline the command reports results that got slower than the tolerance allows,
+ * and with -exit the process exit code is the number of regressions (capped at 255).
+ */
+namespace FGNetBenchmark
+{
+	struct FResult
+	{
+		FString Name;
+		FString Unit;
+		double Value = 0.0;
+		double BaselineValue = -1.0;
+	};
+
+	struct FContext
+	{
+		UWorld* World = nullptr;
+		int32 Scale = 1;
+		TArray<FResult> Results;
+
+		void AddResult(const FString& Name, double Value, const TCHAR* Unit)
+		{
+			FResult& Result = Results.AddDefaulted_GetRef();
+			Result.Name = Name;
+			Result.Value = Value;
+			Result.Unit = Unit;
+			UE_LOG(LogFGNet, Display, TEXT("FGNet.Bench: %-40s %12.3f %s"), *Name, Value, Unit);
+		}
+	};
+
+	typedef void (*FBenchmarkFunction)(FContext&);
+
+	struct FBenchmark
+	{
+		const TCHAR* Name;
+		FBenchmarkFunction Function;
+	};
+
+	static const TCHAR* GetOptimizationName()
+	{
+		return FGNET_DEBUG_OPTIMIZATION ? TEXT("unoptimized") : TEXT("optimized");
+	}
+
+	static double ToNanoseconds(double Seconds, int64 NumOps)
+	{
+		return NumOps > 0 ? (Seconds * 1000000000.0) / static_cast<double>(NumOps) : 0.0;
+	}
+
+	template <typename ActorType>
+	static ActorType* SpawnTransient(UWorld* World)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags = RF_Transient;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		return World->SpawnActor<ActorType>(ActorType::StaticClass(), FTransform::Identity, SpawnParams);
+	}
+
+	static void CreateReplicators(UObject* Outer, int32 NumReplicators, TArray<UFGValueReplicator*>& OutReplicators)
+	{
+		OutReplicators.Reserve(NumReplicators);
+		for (int32 Index = 0; Index < NumReplicators; ++Index)
+		{
+			UFGValueReplicator* Replicator = NewObject<UFGValueReplicator>(Outer, NAME_None, RF_Transient);
+			Replicator->Init();
+			OutReplicators.Add(Replicator);
+		}
+	}
+
+	static void DestroyReplicators(TArray<UFGValueReplicator*>& Replicators)
+	{
+		for (UFGValueReplicator* Replicator : Replicators)
+		{
+			Replicator->SetShouldTick(false);
+			Replicator->MarkPendingKill();
+		}
+
+		Replicators.Reset();
+	}
+
+	static void ValueReplicatorTick(FContext& Context)
+	{
+		// An actor outer has authority in a standalone game, so these take the sending path.
+		AActor* Owner = SpawnTransient<AActor>(Context.World);
+		if (Owner == nullptr)
+			return;
+
+		const int32 NumReplicators = 4096;
+		const int32 NumFrames = 60 * Context.Scale;
+		const float DeltaTime = 1.0f / 60.0f;
+
+		TArray<UFGValueReplicator*> Replicators;
+		CreateReplicators(Owner, NumReplicators, Replicators);
+
+		double TickSeconds = 0.0;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			for (UFGValueReplicator* Replicator : Replicators)
+			{
+				Replicator->SetValue(static_cast<float>(Frame));
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			for (UFGValueReplicator* Replicator : Replicators)
+			{
+				Replicator->Tick(DeltaTime);
+			}
+			TickSeconds += FPlatformTime::Seconds() - StartTime;
+		}
+
+		Context.AddResult(TEXT("ValueReplicator.Tick"), ToNanoseconds(TickSeconds, static_cast<int64>(NumFrames) * NumReplicators), TEXT("ns"));
+
+		DestroyReplicators(Replicators);
+		Owner->Destroy();
+	}
+
+	static void CrumbTrail(FContext& Context, const TCHAR* PatternName, TFunctionRef<int32(int32, FRandomStream&)> GetNumArrivals)
+	{
+		// An unpossessed pawn is not locally controlled, so these take the receiving path.
+		APawn* Owner = SpawnTransient<APawn>(Context.World);
+		if (Owner == nullptr)
+			return;
+
+		const int32 NumReplicators = 1024;
+		const int32 NumFrames = 600 * Context.Scale;
+		const float DeltaTime = 1.0f / 60.0f;
+
+		TArray<UFGValueReplicator*> Replicators;
+		CreateReplicators(Owner, NumReplicators, Replicators);
+
+		FRandomStream RandomStream(1337);
+		int32 SyncTag = 0;
+		double TickSeconds = 0.0;
+
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			const int32 NumArrivals = GetNumArrivals(Frame, RandomStream);
+			for (int32 Arrival = 0; Arrival < NumArrivals; ++Arrival)
+			{
+				const float Value = static_cast<float>(SyncTag);
+				for (UFGValueReplicator* Replicator : Replicators)
+				{
+					Replicator->Multicast_SendReplicatedValue(Replicator->Quantization.MakePayload(SyncTag, Value));
+				}
+				SyncTag++;
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			for (UFGValueReplicator* Replicator : Replicators)
+			{
+				Replicator->Tick(DeltaTime);
+			}
+			TickSeconds += FPlatformTime::Seconds() - StartTime;
+		}
+
+		Context.AddResult(FString::Printf(TEXT("CrumbTrail.%s"), PatternName), ToNanoseconds(TickSeconds, static_cast<int64>(NumFrames) * NumReplicators), TEXT("ns"));
+
+		DestroyReplicators(Replicators);
+		Owner->Destroy();
+	}
+
+	// Arrival patterns for 5 replications per second at 60 fps.
+	static void CrumbTrailUniform(FContext& Context)
+	{
+		CrumbTrail(Context, TEXT("Uniform"), [](int32 Frame, FRandomStream&) { return Frame % 12 == 0 ? 1 : 0; });
+	}
+
+	static void CrumbTrailBurst(FContext& Context)
+	{
+		CrumbTrail(Context, TEXT("Burst"), [](int32 Frame, FRandomStream&) { return Frame % 36 == 0 ? 3 : 0; });
+	}
+
+	static void CrumbTrailJitter(FContext& Context)
+	{
+		CrumbTrail(Context, TEXT("Jitter"), [](int32 Frame, FRandomStream& RandomStream) { return RandomStream.FRand() < (1.0f / 12.0f) ? 1 : 0; });
+	}
+
+	// Same parameters as AFGPlayer::Server_SendMovement and Multicast_SendMovement.
+	static void MovementPacket(FContext& Context)
+	{
+		const int32 NumPackets = 100000 * Context.Scale;
+
+		FVector Location(1234.5f, -678.9f, 100.25f);
+		float TimeStamp = 12.5f;
+		float Forward = 1.0f;
+		float Yaw = 90.0f;
+
+		int64 NumBits = 0;
+		float Sink = 0.0f;
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumPackets; ++Index)
+		{
+			FBitWriter Writer(256, true);
+			Writer << Location << TimeStamp << Forward << Yaw;
+			NumBits = Writer.GetNumBits();
+
+			FBitReader Reader(Writer.GetData(), NumBits);
+			FVector ReadLocation;
+			float ReadTimeStamp, ReadForward, ReadYaw;
+			Reader << ReadLocation << ReadTimeStamp << ReadForward << ReadYaw;
+			Sink += ReadYaw;
+		}
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+		Context.AddResult(TEXT("MovementPacket.RoundTrip"), ToNanoseconds(Seconds, NumPackets), TEXT("ns"));
+		Context.AddResult(TEXT("MovementPacket.Size"), static_cast<double>(NumBits) / 8.0, TEXT("bytes"));
+		UE_LOG(LogFGNet, Verbose, TEXT("FGNet.Bench: movement packet sink %f"), Sink);
+	}
+
+	// Same payload as the UFGValueReplicator RPCs, quantized to 0-100 at 0.1 and unquantized.
+	static void ReplicatorPayload(FContext& Context, const TCHAR* Name, const FFGReplicatorQuantization& Quantization)
+	{
+		const int32 NumPackets = 100000 * Context.Scale;
+
+		int64 NumBits = 0;
+		float Sink = 0.0f;
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumPackets; ++Index)
+		{
+			FFGReplicatorPayload Payload = Quantization.MakePayload(Index, static_cast<float>(Index % 1000) * 0.1f);
+
+			bool bSuccess = false;
+			FBitWriter Writer(256, true);
+			Payload.NetSerialize(Writer, nullptr, bSuccess);
+			NumBits = Writer.GetNumBits();
+
+			FFGReplicatorPayload ReadPayload;
+			FBitReader Reader(Writer.GetData(), NumBits);
+			ReadPayload.NetSerialize(Reader, nullptr, bSuccess);
+			Sink += Quantization.GetValue(ReadPayload);
+		}
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+		Context.AddResult(FString::Printf(TEXT("ReplicatorPayload.%s.RoundTrip"), Name), ToNanoseconds(Seconds, NumPackets), TEXT("ns"));
+		Context.AddResult(FString::Printf(TEXT("ReplicatorPayload.%s.Size"), Name), static_cast<double>(NumBits) / 8.0, TEXT("bytes"));
+		UE_LOG(LogFGNet, Verbose, TEXT("FGNet.Bench: replicator payload sink %f"), Sink);
+	}
+
+	static void ReplicatorPayloadQuantized(FContext& Context)
+	{
+		FFGReplicatorQuantization Quantization;
+		Quantization.bEnabled = true;
+		ReplicatorPayload(Context, TEXT("Quantized"), Quantization);
+	}
+
+	static void ReplicatorPayloadRaw(FContext& Context)
+	{
+		ReplicatorPayload(Context, TEXT("Raw"), FFGReplicatorQuantization());
+	}
+
+	static void GetFreeRocket(FContext& Context)
+	{
+		const int32 CallsPerPlayer = 100000 * Context.Scale;
+
+		UPTRINT Sink = 0;
+		int64 NumCalls = 0;
+		double Seconds = 0.0;
+
+		for (TActorIterator<AFGPlayer> It(Context.World); It; ++It)
+		{
+			const AFGPlayer* Player = *It;
+
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Index = 0; Index < CallsPerPlayer; ++Index)
+			{
+				Sink += reinterpret_cast<UPTRINT>(Player->GetFreeRocket());
+			}
+			Seconds += FPlatformTime::Seconds() - StartTime;
+			NumCalls += CallsPerPlayer;
+		}
+
+		if (NumCalls > 0)
+		{
+			Context.AddResult(TEXT("Player.GetFreeRocket"), ToNanoseconds(Seconds, NumCalls), TEXT("ns"));
+			UE_LOG(LogFGNet, Verbose, TEXT("FGNet.Bench: rocket sink %llu"), static_cast<uint64>(Sink));
+		}
+	}
+
+	static void MovementComponentMove(FContext& Context)
+	{
+		const int32 MovesPerPlayer = 1000 * Context.Scale;
+
+		int64 NumMoves = 0;
+		double Seconds = 0.0;
+
+		for (TActorIterator<AFGPlayer> It(Context.World); It; ++It)
+		{
+			AFGPlayer* Player = *It;
+			UFGMovementComponent* MovementComponent = Player->FindComponentByClass<UFGMovementComponent>();
+			if (MovementComponent == nullptr)
+				continue;
+
+			const FTransform OriginalTransform = Player->GetActorTransform();
+			const FVector MoveDelta = Player->GetActorForwardVector() * 10.0f;
+
+			for (int32 Index = 0; Index < MovesPerPlayer; ++Index)
+			{
+				// Go back now and then so we measure a mix of free and blocked moves.
+				if (Index % 64 == 0)
+				{
+					Player->SetActorTransform(OriginalTransform, false, nullptr, ETeleportType::TeleportPhysics);
+					MovementComponent->InvalidateFloor();
+				}
+
+				const double StartTime = FPlatformTime::Seconds();
+				FFGFrameMovement FrameMovement = MovementComponent->CreateFrameMovement();
+				FrameMovement.AddDelta(MoveDelta);
+				MovementComponent->Move(FrameMovement);
+				Seconds += FPlatformTime::Seconds() - StartTime;
+			}
+
+			NumMoves += MovesPerPlayer;
+			Player->SetActorTransform(OriginalTransform, false, nullptr, ETeleportType::TeleportPhysics);
+			MovementComponent->InvalidateFloor();
+		}
+
+		if (NumMoves > 0)
+		{
+			Context.AddResult(TEXT("MovementComponent.Move"), ToNanoseconds(Seconds, NumMoves), TEXT("ns"));
+		}
+	}
+
+	static void PlayerTick(FContext& Context)
+	{
+		const int32 TicksPerPlayer = 1000 * Context.Scale;
+		const float DeltaTime = 1.0f / 60.0f;
+
+		int64 NumTicks = 0;
+		double Seconds = 0.0;
+
+		for (TActorIterator<AFGPlayer> It(Context.World); It; ++It)
+		{
+			AFGPlayer* Player = *It;
+			const FTransform OriginalTransform = Player->GetActorTransform();
+
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Index = 0; Index < TicksPerPlayer; ++Index)
+			{
+				Player->Tick(DeltaTime);
+			}
+			Seconds += FPlatformTime::Seconds() - StartTime;
+			NumTicks += TicksPerPlayer;
+
+			Player->SetActorTransform(OriginalTransform, false, nullptr, ETeleportType::TeleportPhysics);
+		}
+
+		if (NumTicks > 0)
+		{
+			Context.AddResult(TEXT("Player.Tick"), ToNanoseconds(Seconds, NumTicks), TEXT("ns"));
+		}
+	}
+
+	static const FBenchmark Benchmarks[] =
+	{
+		{ TEXT("ValueReplicatorTick"), &ValueReplicatorTick },
+		{ TEXT("CrumbTrailUniform"), &CrumbTrailUniform },
+		{ TEXT("CrumbTrailBurst"), &CrumbTrailBurst },
+		{ TEXT("CrumbTrailJitter"), &CrumbTrailJitter },
+		{ TEXT("MovementPacket"), &MovementPacket },
+		{ TEXT("ReplicatorPayloadQuantized"), &ReplicatorPayloadQuantized },
+		{ TEXT("ReplicatorPayloadRaw"), &ReplicatorPayloadRaw },
+		{ TEXT("GetFreeRocket"), &GetFreeRocket },
+		{ TEXT("MovementComponentMove"), &MovementComponentMove },
+		{ TEXT("PlayerTick"), &PlayerTick },
+	};
+
+	static bool ReadBaseline(const FString& Path, TMap<FString, double>& OutBaseline)
+	{
+		FString JsonText;
+		if (!FFileHelper::LoadFileToString(JsonText, *Path))
+			return false;
+
+		TSharedPtr<FJsonObject> Root;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(JsonText), Root) || !Root.IsValid())
+			return false;
+
+		const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+		if (!Root->TryGetArrayField(TEXT("results"), Entries))
+			return false;
+
+		for (const TSharedPtr<FJsonValue>& Entry : *Entries)
+		{
+			const TSharedPtr<FJsonObject>* EntryObject = nullptr;
+			if (Entry.IsValid() && Entry->TryGetObject(EntryObject))
+			{
+				OutBaseline.Add((*EntryObject)->GetStringField(TEXT("name")), (*EntryObject)->GetNumberField(TEXT("value")));
+			}
+		}
+
+		return true;
+	}
+
+	static bool WriteJson(const FString& Path, const TArray<FResult>& Results, int32 NumRegressions)
+	{
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetStringField(TEXT("build"), GetOptimizationName());
+		Root->SetNumberField(TEXT("regressions"), NumRegressions);
+
+		TArray<TSharedPtr<FJsonValue>> Entries;
+		for (const FResult& Result : Results)
+		{
+			TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+			Entry->SetStringField(TEXT("name"), Result.Name);
+			Entry->SetNumberField(TEXT("value"), Result.Value);
+			Entry->SetStringField(TEXT("unit"), Result.Unit);
+			if (Result.BaselineValue >= 0.0)
+			{
+				Entry->SetNumberField(TEXT("baseline"), Result.BaselineValue);
+			}
+			Entries.Add(MakeShared<FJsonValueObject>(Entry));
+		}
+		Root->SetArrayField(TEXT("results"), Entries);
+
+		FString JsonText;
+		FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&JsonText));
+		return FFileHelper::SaveStringToFile(JsonText, *Path);
+	}
+
+	static int32 CompareWithBaseline(TArray<FResult>& Results, const TMap<FString, double>& Baseline, float Tolerance)
+	{
+		int32 NumRegressions = 0;
+
+		for (FResult& Result : Results)
+		{
+			const double* BaselineValue = Baseline.Find(Result.Name);
+			if (BaselineValue == nullptr || *BaselineValue <= 0.0)
+				continue;
+
+			Result.BaselineValue = *BaselineValue;
+
+			const double Ratio = Result.Value / *BaselineValue;
+			if (Ratio > 1.0 + Tolerance)
+			{
+				NumRegressions++;
+				UE_LOG(LogFGNet, Warning, TEXT("FGNet.Bench: %s regressed %.3f -> %.3f %s (x%.2f)"), *Result.Name, *BaselineValue, Result.Value, *Result.Unit, Ratio);
+			}
+		}
+
+		return NumRegressions;
+	}
+
+	static void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		if (World == nullptr)
+			return;
+
+		const FString CommandLine = FString::Join(Args, TEXT(" "));
+
+		FContext Context;
+		Context.World = World;
+		FParse::Value(*CommandLine, TEXT("-scale="), Context.Scale);
+		Context.Scale = FMath::Max(Context.Scale, 1);
+
+		FString Filter;
+		if (Args.Num() > 0 && !Args[0].StartsWith(TEXT("-")))
+		{
+			Filter = Args[0];
+		}
+
+		UE_LOG(LogFGNet, Display, TEXT("FGNet.Bench: running %s build"), GetOptimizationName());
+
+		for (const FBenchmark& Benchmark : Benchmarks)
+		{
+			if (Filter.IsEmpty() || FCString::Stristr(Benchmark.Name, *Filter) != nullptr)
+			{
+				Benchmark.Function(Context);
+			}
+		}
+
+		int32 NumRegressions = 0;
+
+		FString BaselinePath;
+		if (FParse::Value(*CommandLine, TEXT("-baseline="), BaselinePath))
+		{
+			float Tolerance = 0.1f;
+			FParse::Value(*CommandLine, TEXT("-tolerance="), Tolerance);
+
+			TMap<FString, double> Baseline;
+			if (ReadBaseline(BaselinePath, Baseline))
+			{
+				NumRegressions = CompareWithBaseline(Context.Results, Baseline, Tolerance);
+				UE_LOG(LogFGNet, Display, TEXT("FGNet.Bench: %d regressions against %s"), NumRegressions, *BaselinePath);
+			}
+			else
+			{
+				UE_LOG(LogFGNet, Error, TEXT("FGNet.Bench: could not read baseline %s"), *BaselinePath);
+			}
+		}
+
+		FString JsonPath;
+		if (FParse::Value(*CommandLine, TEXT("-json="), JsonPath))
+		{
+			if (!WriteJson(JsonPath, Context.Results, NumRegressions))
+			{
+				UE_LOG(LogFGNet, Error, TEXT("FGNet.Bench: could not write %s"), *JsonPath);
+			}
+		}
+
+		if (FParse::Param(*CommandLine, TEXT("exit")))
+		{
+			FPlatformMisc::RequestExitWithStatus(false, static_cast<uint8>(FMath::Min(NumRegressions, 255)));
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs FGNetBenchCommand(
+	TEXT("FGNet.Bench"),
+	TEXT("Runs the FGNet netcode benchmarks. Usage: FGNet.Bench [Filter] [-scale=N] [-json=Path] [-baseline=Path] [-tolerance=0.1] [-exit]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FGNetBenchmark::Run));
@@ -0,0 +1,135 @@
+#include "FGExplosionPool.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "../FGNetStats.h"
+
+static TAutoConsoleVariable<int32> CVarMaxActiveExplosions(
+	TEXT("FGNet.Explosions.MaxActive"),
+	32,
+	TEXT("Most explosions playing at once, the oldest is recycled past this."));
+
+static TAutoConsoleVariable<float> CVarExplosionCullDistance(
+	TEXT("FGNet.Explosions.CullDistance"),
+	8000.0f,
+	TEXT("Explosions further than this from the local view are not spawned. 0 disables culling."));
+
+bool UFGExplosionPool::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if !FGNET_WITH_COSMETICS
+	return false;
+#else
+	return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+void UFGExplosionPool::Deinitialize()
+{
+	for (UParticleSystemComponent* Component : ActiveComponents)
+	{
+		if (Component != nullptr)
+			Component->DestroyComponent();
+	}
+
+	for (UParticleSystemComponent* Component : FreeComponents)
+	{
+		if (Component != nullptr)
+			Component->DestroyComponent();
+	}
+
+	ActiveComponents.Empty();
+	FreeComponents.Empty();
+
+	Super::Deinitialize();
+}
+
+UFGExplosionPool* UFGExplosionPool::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject != nullptr ? WorldContextObject->GetWorld() : nullptr;
+	return World != nullptr ? World->GetSubsystem<UFGExplosionPool>() : nullptr;
+}
+
+void UFGExplosionPool::SpawnExplosion(UParticleSystem* Template, const FVector& Location, const FRotator& Rotation)
+{
+#if FGNET_WITH_COSMETICS
+	if (Template == nullptr || GetWorld()->GetNetMode() == NM_DedicatedServer)
+		return;
+
+	if (IsCulled(Location))
+	{
+		INC_DWORD_STAT(STAT_FGNet_CulledExplosions);
+		return;
+	}
+
+	UParticleSystemComponent* Component = AcquireComponent();
+	if (Component == nullptr)
+		return;
+
+	if (Component->Template != Template)
+	{
+		Component->SetTemplate(Template);
+	}
+
+	Component->SetWorldLocationAndRotation(Location, Rotation);
+	Component->ActivateSystem(true);
+
+	ActiveComponents.Add(Component);
+	INC_DWORD_STAT(STAT_FGNet_PooledExplosions);
+#endif
+}
+
+void UFGExplosionPool::OnExplosionFinished(UParticleSystemComponent* Component)
+{
+	// Recycled components finish too, they are already back in use by then.
+	const int32 Index = ActiveComponents.Find(Component);
+	if (Index == INDEX_NONE)
+		return;
+
+	ActiveComponents.RemoveAt(Index, 1, false);
+	FreeComponents.Add(Component);
+}
+
+UParticleSystemComponent* UFGExplosionPool::AcquireComponent()
+{
+	const int32 MaxActive = FMath::Max(CVarMaxActiveExplosions.GetValueOnGameThread(), 1);
+	if (ActiveComponents.Num() >= MaxActive)
+	{
+		UParticleSystemComponent* Oldest = ActiveComponents[0];
+		ActiveComponents.RemoveAt(0, 1, false);
+		Oldest->DeactivateImmediate();
+		return Oldest;
+	}
+
+	if (FreeComponents.Num() > 0)
+		return FreeComponents.Pop(false);
+
+	UWorld* World = GetWorld();
+	AWorldSettings* WorldSettings = World->GetWorldSettings();
+
+	UParticleSystemComponent* Component = NewObject<UParticleSystemComponent>(WorldSettings != nullptr ? static_cast<UObject*>(WorldSettings) : static_cast<UObject*>(World));
+	Component->bAutoDestroy = false;
+	Component->bAutoActivate = false;
+	Component->SetUsingAbsoluteLocation(true);
+	Component->SetUsingAbsoluteRotation(true);
+	Component->SetUsingAbsoluteScale(true);
+	Component->OnSystemFinished.AddDynamic(this, &UFGExplosionPool::OnExplosionFinished);
+	Component->RegisterComponentWithWorld(World);
+	return Component;
+}
+
+bool UFGExplosionPool::IsCulled(const FVector& Location) const
+{
+	const float CullDistance = CVarExplosionCullDistance.GetValueOnGameThread();
+	if (CullDistance <= 0.0f)
+		return false;
+
+	const APlayerController* PlayerController = GEngine->GetFirstLocalPlayerController(GetWorld());
+	if (PlayerController == nullptr || PlayerController->PlayerCameraManager == nullptr)
+		return false;
+
+	return FVector::DistSquared(PlayerController->PlayerCameraManager->GetCameraLocation(), Location) > FMath::Square(CullDistance);
+}
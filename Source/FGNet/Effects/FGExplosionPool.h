@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "FGExplosionPool.generated.h"
+
+class UParticleSystem;
+class UParticleSystemComponent;
+
+/*
+ * Reuses particle components for explosions instead of spawning an auto-destroying one per impact.
+ * Caps the number of concurrent explosions, recycling the oldest, and skips explosions too far from the local view.
+ * Not created on dedicated servers and compiled out of server builds, there is nobody to show explosions to.
+ */
+UCLASS()
+class FGNET_API UFGExplosionPool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+
+	static UFGExplosionPool* Get(const UObject* WorldContextObject);
+
+	void SpawnExplosion(UParticleSystem* Template, const FVector& Location, const FRotator& Rotation);
+
+	int32 GetNumActive() const { return ActiveComponents.Num(); }
+	int32 GetNumFree() const { return FreeComponents.Num(); }
+
+private:
+	UFUNCTION()
+	void OnExplosionFinished(UParticleSystemComponent* Component);
+
+	UParticleSystemComponent* AcquireComponent();
+	bool IsCulled(const FVector& Location) const;
+
+	// Oldest first.
+	UPROPERTY(Transient)
+	TArray<UParticleSystemComponent*> ActiveComponents;
+
+	UPROPERTY(Transient)
+	TArray<UParticleSystemComponent*> FreeComponents;
+};
@@ -1,5 +1,6 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
+using System;
 using UnrealBuildTool;
 
 public class FGNet : ModuleRules
@@ -10,7 +11,30 @@ public class FGNet : ModuleRules
 	
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "UMG", "Engine", "InputCore" });
 
-		PrivateDependencyModuleNames.AddRange(new string[] {  });
+		PrivateDependencyModuleNames.AddRange(new string[] { "Json", "EngineSettings" });
+
+		// FGNet is optimized like any other game module. To step through it in a Development build,
+		// build with FGNET_DEBUG_OPTIMIZATION=1 set in the environment instead of adding #pragma optimize to source files.
+		bool bDebugOptimization = Target.Configuration == UnrealTargetConfiguration.Development
+			&& Environment.GetEnvironmentVariable("FGNET_DEBUG_OPTIMIZATION") == "1";
+
+		if (bDebugOptimization)
+		{
+			OptimizeCode = CodeOptimization.Never;
+		}
+
+		PublicDefinitions.Add("FGNET_DEBUG_OPTIMIZATION=" + (bDebugOptimization ? "1" : "0"));
+
+		// FGNet cycle stats and trace events are compiled out of Shipping. Build with FGNET_WITH_PROFILING=1 set
+		// in the environment to keep the trace scopes and events, for example to profile a Shipping server with -trace.
+		if (Environment.GetEnvironmentVariable("FGNET_WITH_PROFILING") == "1")
+		{
+			PublicDefinitions.Add("FGNET_WITH_PROFILING=1");
+		}
+
+		// Widgets, mesh bobbing, particles, debug draws and camera components are only compiled into targets
+		// that render. FGNetServer builds without them.
+		PublicDefinitions.Add("FGNET_WITH_COSMETICS=" + (Target.Type == TargetType.Server ? "0" : "1"));
 
 		// Uncomment if you are using Slate UI
 		// PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
@@ -1,6 +1,50 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "FGNet.h"
+#include "FGNetStats.h"
 #include "Modules/ModuleManager.h"
 
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, FGNet, "FGNet" );
+
+DEFINE_LOG_CATEGORY(LogFGNet);
+
+DEFINE_STAT(STAT_FGNet_TickPhase);
+DEFINE_STAT(STAT_FGNet_PlayerInput);
+DEFINE_STAT(STAT_FGNet_PlayerSimulate);
+DEFINE_STAT(STAT_FGNet_PlayerNetSend);
+DEFINE_STAT(STAT_FGNet_PlayerCosmetic);
+DEFINE_STAT(STAT_FGNet_MovementMove);
+DEFINE_STAT(STAT_FGNet_RocketSimulate);
+DEFINE_STAT(STAT_FGNet_ReplicatorTick);
+DEFINE_STAT(STAT_FGNet_ReplicatorTickManager);
+DEFINE_STAT(STAT_FGNet_SendScheduler);
+DEFINE_STAT(STAT_FGNet_SnapshotBuild);
+DEFINE_STAT(STAT_FGNet_SnapshotReceive);
+DEFINE_STAT(STAT_FGNet_JoinStep);
+DEFINE_STAT(STAT_FGNet_BotDecisions);
+DEFINE_STAT(STAT_FGNet_ServerSendMovement);
+DEFINE_STAT(STAT_FGNet_MulticastSendMovement);
+DEFINE_STAT(STAT_FGNet_ServerFireRocket);
+DEFINE_STAT(STAT_FGNet_MulticastFireRocket);
+DEFINE_STAT(STAT_FGNet_ServerOnPickup);
+DEFINE_STAT(STAT_FGNet_ReplicatorValueRPC);
+
+DEFINE_STAT(STAT_FGNet_Moves);
+DEFINE_STAT(STAT_FGNet_MoveIterations);
+DEFINE_STAT(STAT_FGNet_MovesOutOfIterations);
+DEFINE_STAT(STAT_FGNet_ClampedMoves);
+DEFINE_STAT(STAT_FGNet_RejectedMoves);
+DEFINE_STAT(STAT_FGNet_RejectedPickups);
+DEFINE_STAT(STAT_FGNet_AwakeReplicators);
+DEFINE_STAT(STAT_FGNet_ScheduledSends);
+DEFINE_STAT(STAT_FGNet_DeferredSends);
+DEFINE_STAT(STAT_FGNet_SnapshotEntities);
+DEFINE_STAT(STAT_FGNet_SnapshotBytes);
+DEFINE_STAT(STAT_FGNet_DormancyWakes);
+DEFINE_STAT(STAT_FGNet_DormancySleeps);
+DEFINE_STAT(STAT_FGNet_PooledExplosions);
+DEFINE_STAT(STAT_FGNet_CulledExplosions);
+DEFINE_STAT(STAT_FGNet_JoinSteps);
+DEFINE_STAT(STAT_FGNet_PendingJoins);
+DEFINE_STAT(STAT_FGNet_Bots);
+DEFINE_STAT(STAT_FGNet_ReducedSignificance);
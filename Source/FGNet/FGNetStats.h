@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+// Cycle stats and trace scopes compile out of shipping builds. FGNET_WITH_PROFILING=1 keeps the trace scopes and
+// events, see FGNet.Build.cs. Stats themselves never exist in Shipping.
+#ifndef FGNET_WITH_PROFILING
+#define FGNET_WITH_PROFILING !UE_BUILD_SHIPPING
+#endif
+
+#if FGNET_WITH_PROFILING && STATS
+// Shows up in stat FGNet with call counts, the cycle counter already emits the CPU scope for Unreal Insights.
+#define FGNET_SCOPE_CYCLE_COUNTER(Stat) SCOPE_CYCLE_COUNTER(Stat)
+#elif FGNET_WITH_PROFILING
+// No stats in Shipping, only the CPU scope is left.
+#define FGNET_SCOPE_CYCLE_COUNTER(Stat) TRACE_CPUPROFILER_EVENT_SCOPE(Stat)
+#else
+#define FGNET_SCOPE_CYCLE_COUNTER(Stat)
+#endif
+
+DECLARE_STATS_GROUP(TEXT("FGNet"), STATGROUP_FGNet, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tick Phase"), STAT_FGNet_TickPhase, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Player Input"), STAT_FGNet_PlayerInput, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Player Simulate"), STAT_FGNet_PlayerSimulate, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Player Net Send"), STAT_FGNet_PlayerNetSend, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Player Cosmetic"), STAT_FGNet_PlayerCosmetic, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Movement Move"), STAT_FGNet_MovementMove, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rocket Simulate"), STAT_FGNet_RocketSimulate, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Replicator Tick"), STAT_FGNet_ReplicatorTick, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Replicator Tick Manager"), STAT_FGNet_ReplicatorTickManager, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Send Scheduler"), STAT_FGNet_SendScheduler, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Snapshot Build"), STAT_FGNet_SnapshotBuild, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Snapshot Receive"), STAT_FGNet_SnapshotReceive, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Join Step"), STAT_FGNet_JoinStep, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Bot Decisions"), STAT_FGNet_BotDecisions, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RPC Server Send Movement"), STAT_FGNet_ServerSendMovement, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RPC Multicast Send Movement"), STAT_FGNet_MulticastSendMovement, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RPC Server Fire Rocket"), STAT_FGNet_ServerFireRocket, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RPC Multicast Fire Rocket"), STAT_FGNet_MulticastFireRocket, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RPC Server On Pickup"), STAT_FGNet_ServerOnPickup, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RPC Replicator Value"), STAT_FGNet_ReplicatorValueRPC, STATGROUP_FGNet, FGNET_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Moves"), STAT_FGNet_Moves, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Move Iterations"), STAT_FGNet_MoveIterations, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Moves Out Of Iterations"), STAT_FGNet_MovesOutOfIterations, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Clamped Client Moves"), STAT_FGNet_ClampedMoves, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Rejected Client Moves"), STAT_FGNet_RejectedMoves, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Rejected Pickups"), STAT_FGNet_RejectedPickups, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Awake Replicators"), STAT_FGNet_AwakeReplicators, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Scheduled Sends"), STAT_FGNet_ScheduledSends, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Deferred Sends"), STAT_FGNet_DeferredSends, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Snapshot Entities"), STAT_FGNet_SnapshotEntities, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Snapshot Bytes"), STAT_FGNet_SnapshotBytes, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Dormancy Wakes"), STAT_FGNet_DormancyWakes, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Dormancy Sleeps"), STAT_FGNet_DormancySleeps, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pooled Explosions"), STAT_FGNet_PooledExplosions, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Culled Explosions"), STAT_FGNet_CulledExplosions, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Join Steps"), STAT_FGNet_JoinSteps, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pending Joins"), STAT_FGNet_PendingJoins, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bots"), STAT_FGNet_Bots, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Reduced Significance Proxies"), STAT_FGNet_ReducedSignificance, STATGROUP_FGNet, FGNET_API);
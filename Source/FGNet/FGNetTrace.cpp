@@ -0,0 +1,38 @@
+#include "FGNetTrace.h"
+
+#if FGNET_WITH_TRACE
+
+#include "HAL/PlatformTime.h"
+#include "UObject/Object.h"
+
+UE_TRACE_CHANNEL_DEFINE(FGNetChannel)
+
+UE_TRACE_EVENT_BEGIN(FGNet, NetSend)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, ObjectId)
+	UE_TRACE_EVENT_FIELD(uint32, NumBytes)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(FGNet, Correction)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, ObjectId)
+	UE_TRACE_EVENT_FIELD(float, Distance)
+UE_TRACE_EVENT_END()
+
+void FFGNetTrace::OutputNetSend(const UObject* Sender, uint32 NumBytes)
+{
+	UE_TRACE_LOG(FGNet, NetSend, FGNetChannel)
+		<< NetSend.Cycle(FPlatformTime::Cycles64())
+		<< NetSend.ObjectId(Sender != nullptr ? Sender->GetUniqueID() : 0)
+		<< NetSend.NumBytes(NumBytes);
+}
+
+void FFGNetTrace::OutputCorrection(const UObject* Corrected, float Distance)
+{
+	UE_TRACE_LOG(FGNet, Correction, FGNetChannel)
+		<< Correction.Cycle(FPlatformTime::Cycles64())
+		<< Correction.ObjectId(Corrected != nullptr ? Corrected->GetUniqueID() : 0)
+		<< Correction.Distance(Distance);
+}
+
+#endif
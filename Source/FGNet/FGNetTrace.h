@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include "FGNetStats.h"
+
+class UObject;
+
+#define FGNET_WITH_TRACE (FGNET_WITH_PROFILING && UE_TRACE_ENABLED)
+
+#if FGNET_WITH_TRACE
+
+UE_TRACE_CHANNEL_EXTERN(FGNetChannel, FGNET_API)
+
+// Custom Unreal Insights events, enable with -trace=cpu,fgnet.
+struct FGNET_API FFGNetTrace
+{
+	static void OutputNetSend(const UObject* Sender, uint32 NumBytes);
+	static void OutputCorrection(const UObject* Corrected, float Distance);
+};
+
+#define FGNET_TRACE_NET_SEND(Sender, NumBytes) FFGNetTrace::OutputNetSend(Sender, NumBytes)
+#define FGNET_TRACE_CORRECTION(Corrected, Distance) FFGNetTrace::OutputCorrection(Corrected, Distance)
+
+#else
+
+#define FGNET_TRACE_NET_SEND(Sender, NumBytes)
+#define FGNET_TRACE_CORRECTION(Corrected, Distance)
+
+#endif
@@ -6,11 +6,14 @@
 #include "Components/StaticMeshComponent.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
+#include "Tick/FGTickManager.h"
+#include "Net/FGNetDormancy.h"
 
 AFGPickup::AFGPickup()
 {
-	PrimaryActorTick.bStartWithTickEnabled = true;
-	PrimaryActorTick.bCanEverTick = true;
+	// Pickups only tick to animate the mesh.
+	PrimaryActorTick.bStartWithTickEnabled = FGNET_WITH_COSMETICS != 0;
+	PrimaryActorTick.bCanEverTick = FGNET_WITH_COSMETICS != 0;
 
 	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("SceneRoot"));
 
@@ -23,6 +26,10 @@ AFGPickup::AFGPickup()
 	MeshComponent->SetCollisionProfileName(TEXT("NoCollision"));
 
 	SetReplicates(true);
+
+	// Taking and respawning are simulated from overlaps on every machine and nothing about it replicates,
+	// so pickups have nothing to say after they exist on the client and never need to wake up.
+	NetDormancy = DORM_Initial;
 }
 
 void AFGPickup::BeginPlay()
@@ -32,6 +39,20 @@ void AFGPickup::BeginPlay()
 	SphereComponent->OnComponentBeginOverlap.AddDynamic(this, &AFGPickup::OverlapBegin);
 
 	CachedMeshRelativeLocation = MeshComponent->GetRelativeLocation();
+
+	// Initial dormancy only works for actors placed in the map, spawned ones have to replicate once first.
+	if (!IsNetStartupActor())
+	{
+		FFGNetDormancy::Sleep(this);
+	}
+
+#if FGNET_WITH_COSMETICS
+	if (UFGTickManager* TickManager = UFGTickManager::Get(this))
+	{
+		SetActorTickEnabled(false);
+		TickManager->RegisterPickup(this);
+	}
+#endif
 }
 
 void AFGPickup::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -42,25 +63,68 @@ void AFGPickup::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	{
 		World->GetTimerManager().ClearTimer(ReActivateHandle);
 	}
+
+	if (UFGTickManager* TickManager = UFGTickManager::Get(this))
+	{
+		TickManager->UnregisterPickup(this);
+	}
 }
 
 void AFGPickup::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	const float PulsatingValuie = FMath::MakePulsatingValue(GetWorld()->GetTimeSeconds(), 0.65f) * 30.0f;
-	const FVector NewLocation = CachedMeshRelativeLocation + FVector(0.0f, 0.0f, PulsatingValuie);
-	FHitResult Hit;
-	
-	MeshComponent->SetRelativeLocation(NewLocation, false, &Hit, ETeleportType::TeleportPhysics);
-	MeshComponent->AddRelativeRotation(FRotator(0.0f, 20.0f * DeltaTime, 0.0f), false, &Hit, ETeleportType::TeleportPhysics);
+	TickCosmetic(DeltaTime);
+}
+
+void AFGPickup::TickCosmetic(float DeltaTime)
+{
+#if FGNET_WITH_COSMETICS
+	FFGPickupCosmeticState CosmeticState;
+	if (ComputeCosmetic(DeltaTime, GetWorld()->GetTimeSeconds(), CosmeticState))
+	{
+		ApplyCosmetic(CosmeticState);
+	}
+#endif
+}
+
+bool AFGPickup::ComputeCosmetic(float DeltaTime, float TimeSeconds, FFGPickupCosmeticState& OutState) const
+{
+	const float PulsatingValuie = FMath::MakePulsatingValue(TimeSeconds, 0.65f) * 30.0f;
+	OutState.MeshRelativeLocation = CachedMeshRelativeLocation + FVector(0.0f, 0.0f, PulsatingValuie);
+	OutState.MeshRelativeRotation = MeshComponent->GetRelativeRotation() + FRotator(0.0f, 20.0f * DeltaTime, 0.0f);
+	return true;
+}
+
+void AFGPickup::ApplyCosmetic(const FFGPickupCosmeticState& State)
+{
+	MeshComponent->SetRelativeLocationAndRotation(State.MeshRelativeLocation, State.MeshRelativeRotation, false, nullptr, ETeleportType::TeleportPhysics);
+}
+
+void AFGPickup::SetPickupTickEnabled(bool bEnabled)
+{
+#if FGNET_WITH_COSMETICS
+	if (UFGTickManager* TickManager = UFGTickManager::Get(this))
+	{
+		if (bEnabled)
+			TickManager->RegisterPickup(this);
+		else
+			TickManager->UnregisterPickup(this);
+	}
+	else
+	{
+		SetActorTickEnabled(bEnabled);
+	}
+#endif
 }
 
 void AFGPickup::ReActivatePickup()
 {
 	bPickedUp = false;
+	bClaimed = false;
 	RootComponent->SetVisibility(true, true);
 	SphereComponent->SetCollisionProfileName(TEXT("OverlapAllDynamic"));
+	SetPickupTickEnabled(true);
 }
 
 void AFGPickup::OverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
@@ -73,10 +137,24 @@ void AFGPickup::OverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* O
 	if (AFGPlayer* Player = Cast<AFGPlayer>(OtherActor))
 	{
 		Player->OnPickup(this);
-		bPickedUp = true;
-		SphereComponent->SetCollisionProfileName(TEXT("NoCollision"));
-		RootComponent->SetVisibility(false, true);
-		GetWorldTimerManager().SetTimer(ReActivateHandle, this, &AFGPickup::ReActivatePickup, ReActivateTime, false);
-		SetActorTickEnabled(false);
+		TakePickup();
 	}
+}
+
+void AFGPickup::Claim()
+{
+	bClaimed = true;
+
+	// The server did not see the overlap, start the respawn here so the claim is cleared again.
+	if (!bPickedUp)
+		TakePickup();
+}
+
+void AFGPickup::TakePickup()
+{
+	bPickedUp = true;
+	SphereComponent->SetCollisionProfileName(TEXT("NoCollision"));
+	RootComponent->SetVisibility(false, true);
+	GetWorldTimerManager().SetTimer(ReActivateHandle, this, &AFGPickup::ReActivatePickup, ReActivateTime, false);
+	SetPickupTickEnabled(false);
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 
 class USphereComponent;
 class UStaticMeshComponent;
+struct FFGPickupCosmeticState;
 
 UENUM(BlueprintType)
 enum class EFGPickupType : uint8
@@ -24,6 +25,13 @@ public:
 
 	virtual void Tick(float DeltaTime) override;
 
+	// Cosmetic tick, called by UFGTickManager or from Tick when there is no manager.
+	void TickCosmetic(float DeltaTime);
+
+	// Safe to call from worker threads.
+	bool ComputeCosmetic(float DeltaTime, float TimeSeconds, FFGPickupCosmeticState& OutState) const;
+	void ApplyCosmetic(const FFGPickupCosmeticState& State);
+
 	UPROPERTY(VisibleDefaultsOnly, Category = Collision)
 		USphereComponent* SphereComponent;
 
@@ -39,7 +47,20 @@ public:
 	UPROPERTY(EditAnywhere)
 	float ReActivateTime = 5.0f;
 
+	bool IsPickedUp() const { return bPickedUp; }
+
+	// Server, whether a player has been given this pickup's rockets since it last respawned.
+	bool IsClaimed() const { return bClaimed; }
+	void Claim();
+
 private:
+	template <typename ElementType>
+	friend class TFGTickList;
+
+	int32 TickListIndex = INDEX_NONE;
+
+	void SetPickupTickEnabled(bool bEnabled);
+	void TakePickup();
 
 	FVector CachedMeshRelativeLocation = FVector::ZeroVector;
 	FTimerHandle ReActivateHandle;
@@ -51,4 +72,5 @@ private:
 	void OverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult &SweepResult);
 
 	bool bPickedUp = false;
+	bool bClaimed = false;
 };
\ No newline at end of file
@@ -1,8 +1,12 @@
 #include "FGRocket.h"
 #include "Components/StaticMeshComponent.h"
 #include "Engine/World.h"
-#include "Kismet/GameplayStatics.h"
 #include "DrawDebugHelpers.h"
+#include "Tick/FGTickManager.h"
+#include "Tick/FGSignificanceManager.h"
+#include "Net/FGNetDormancy.h"
+#include "Effects/FGExplosionPool.h"
+#include "FGNetStats.h"
 
 AFGRocket::AFGRocket()
 {
@@ -17,6 +21,9 @@ AFGRocket::AFGRocket()
 	MeshComponent->SetCollisionProfileName(TEXT("NoCollision"));
 
 	SetReplicates(true);
+
+	// Pooled rockets replicate once when spawned and are idle most of the match.
+	NetDormancy = DORM_DormantAll;
 }
 
 void AFGRocket::BeginPlay()
@@ -30,79 +37,181 @@ void AFGRocket::BeginPlay()
 	SetRocketVisibility(false);
 }
 
-void AFGRocket::Tick(float DeltaTime)
+void AFGRocket::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	if (UFGTickManager* TickManager = UFGTickManager::Get(this))
+	{
+		TickManager->UnregisterRocket(this);
+	}
 
-	LifeTimeElapsed -= DeltaTime;
-	DistanceMoved += MovementVelocity * DeltaTime;
+	Super::EndPlay(EndPlayReason);
+}
 
-	FacingRotationStart = FQuat::Slerp(FacingRotationStart.ToOrientationQuat(), FacingRotationCorrection, 0.9f * DeltaTime).Vector();
+void AFGRocket::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
 
-#if !UE_BUILD_SHIPPING
-	if (bDebugDrawCorrection)
-	{
-		const float ArrowLength = 3000.0f;
-		const float ArrowSize = 50.0f;
-		DrawDebugDirectionalArrow(GetWorld(), RocketStartLocation, RocketStartLocation + OriginalFacingDirection * ArrowLength, ArrowSize, FColor::Red);
-		DrawDebugDirectionalArrow(GetWorld(), RocketStartLocation, RocketStartLocation + FacingRotationStart * ArrowLength, ArrowSize, FColor::Green);
-	}
-#endif
+	TickSimulate(DeltaTime);
+	TickCosmetic(DeltaTime);
+}
 
-	const FVector NewLocation = RocketStartLocation + FacingRotationStart * DistanceMoved;
+void AFGRocket::TickSimulate(float DeltaTime)
+{
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_RocketSimulate);
 
-	SetActorLocation(NewLocation);
+	FlightTime += DeltaTime;
 
+	const float SimulateUntil = FMath::Min(FlightTime, LifeTime);
+	const float StepTime = SimulationStepTime * SignificanceStepScale;
 	FHitResult Hit;
-	const FVector StartLoc = NewLocation;
-	const FVector EndLoc = StartLoc + FacingRotationStart * 100.0f;
-	GetWorld()->LineTraceSingleByChannel(Hit, StartLoc, EndLoc, ECC_Visibility, CachedCollisionQueryParams);
 
-	if (Hit.bBlockingHit)
+	while (SimulatedTime + StepTime <= SimulateUntil)
 	{
-		Explode();
+		if (SweepTo(SimulatedTime + StepTime, Hit))
+		{
+			SetActorLocation(Hit.Location);
+			Explode();
+			return;
+		}
 	}
 
-	if (LifeTimeElapsed < 0.0f)
+	if (FlightTime >= LifeTime)
 	{
+		// Sweep the last partial step so the end of the path is covered too.
+		if (SimulatedTime < LifeTime && SweepTo(LifeTime, Hit))
+		{
+			SetActorLocation(Hit.Location);
+		}
+		else
+		{
+			SetActorLocation(SimulatedLocation);
+		}
+
 		Explode();
+		return;
+	}
+
+	// Render at the frame's time, at most one step ahead of what has been swept.
+	FacingRotationStart = GetFacingDirectionAtTime(FlightTime);
+	SetActorLocation(GetLocationAtTime(FlightTime));
+}
+
+bool AFGRocket::SweepTo(float Time, FHitResult& OutHit)
+{
+	const FVector NewLocation = GetLocationAtTime(Time);
+
+	const bool bHit = GetWorld()->SweepSingleByChannel(OutHit, SimulatedLocation, NewLocation, FQuat::Identity, ECC_Visibility, FCollisionShape::MakeSphere(CollisionRadius), CachedCollisionQueryParams);
+
+	SimulatedLocation = NewLocation;
+	SimulatedTime = Time;
+	return bHit;
+}
+
+FVector AFGRocket::GetFacingDirectionAtTime(float Time) const
+{
+	// Closed form of slerping CorrectionRate * DeltaTime of the way towards the correction every frame.
+	const float Alpha = 1.0f - FMath::Exp(-CorrectionRate * FMath::Max(Time - CorrectionTime, 0.0f));
+	return FQuat::Slerp(CorrectionStartDirection, FacingRotationCorrection, Alpha).GetForwardVector();
+}
+
+FVector AFGRocket::GetLocationAtTime(float Time) const
+{
+	return RocketStartLocation + GetFacingDirectionAtTime(Time) * (MovementVelocity * Time);
+}
+
+void AFGRocket::TickCosmetic(float DeltaTime)
+{
+#if FGNET_WITH_COSMETICS && !UE_BUILD_SHIPPING
+	if (bDebugDrawCorrection)
+	{
+		const float ArrowLength = 3000.0f;
+		const float ArrowSize = 50.0f;
+		DrawDebugDirectionalArrow(GetWorld(), RocketStartLocation, RocketStartLocation + OriginalFacingDirection * ArrowLength, ArrowSize, FColor::Red);
+		DrawDebugDirectionalArrow(GetWorld(), RocketStartLocation, RocketStartLocation + FacingRotationStart * ArrowLength, ArrowSize, FColor::Green);
 	}
+#endif
 }
 
 void AFGRocket::StartMoving(const FVector& Forward, const FVector& InStartLocation)
 {
 	FacingRotationStart = Forward;
 	FacingRotationCorrection = FacingRotationStart.ToOrientationQuat();
+	CorrectionStartDirection = FacingRotationCorrection;
+	CorrectionTime = 0.0f;
 	RocketStartLocation = InStartLocation;
+	SimulatedLocation = InStartLocation;
 	SetActorLocationAndRotation(InStartLocation, Forward.Rotation());
 	bIsFree = false;
-	SetActorTickEnabled(true);
+	FFGNetDormancy::Wake(this);
+	SetRocketTickEnabled(true);
 	SetRocketVisibility(true);
-	LifeTimeElapsed = LifeTime;
-	DistanceMoved = 0.0f;
+	FlightTime = 0.0f;
+	SimulatedTime = 0.0f;
 	OriginalFacingDirection = FacingRotationStart;
+
+	// Start every flight at full rate, the significance manager catches up within a few frames.
+	SetSignificance(EFGSignificance::High);
+}
+
+void AFGRocket::SetSignificance(EFGSignificance InSignificance)
+{
+	Significance = InSignificance;
+
+	switch (Significance)
+	{
+	case EFGSignificance::Medium:
+		SignificanceStepScale = 2.0f;
+		break;
+	case EFGSignificance::Low:
+		SignificanceStepScale = 4.0f;
+		break;
+	default:
+		SignificanceStepScale = 1.0f;
+		break;
+	}
 }
 
 void AFGRocket::ApplyCorrection(const FVector& Forward)
 {
+	// Continue turning from wherever the facing is now, so the path stays continuous.
+	CorrectionStartDirection = GetFacingDirectionAtTime(FlightTime).ToOrientationQuat();
+	CorrectionTime = FlightTime;
 	FacingRotationCorrection = Forward.ToOrientationQuat();
 }
 
 void AFGRocket::Explode()
 {
-	if (Explosion != nullptr)
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), Explosion, GetActorLocation(), GetActorRotation(), true);
+#if FGNET_WITH_COSMETICS
+	if (UFGExplosionPool* ExplosionPool = UFGExplosionPool::Get(this))
+		ExplosionPool->SpawnExplosion(Explosion, GetActorLocation(), GetActorRotation());
+#endif
 	MakeFree();
 }
 
 void AFGRocket::MakeFree()
 {
 	bIsFree = true;
-	SetActorTickEnabled(false);
+	FFGNetDormancy::Sleep(this);
+	SetRocketTickEnabled(false);
 	SetRocketVisibility(false);
 }
 
 void AFGRocket::SetRocketVisibility(bool bVisible)
 {
 	RootComponent->SetVisibility(bVisible, true);
-}
\ No newline at end of file
+}
+
+void AFGRocket::SetRocketTickEnabled(bool bEnabled)
+{
+	if (UFGTickManager* TickManager = UFGTickManager::Get(this))
+	{
+		if (bEnabled)
+			TickManager->RegisterRocket(this);
+		else
+			TickManager->UnregisterRocket(this);
+	}
+	else
+	{
+		SetActorTickEnabled(bEnabled);
+	}
+}
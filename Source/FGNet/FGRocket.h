@@ -3,6 +3,8 @@
 #include "GameFramework/Actor.h"
 #include "FGRocket.generated.h"
 
+enum class EFGSignificance : uint8;
+
 UCLASS()
 class FGNET_API AFGRocket : public AActor
 {
@@ -11,19 +13,33 @@ public:
 	AFGRocket();
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	virtual void Tick(float DeltaTime) override;
 
+	// Tick phases, called by UFGTickManager or from Tick when there is no manager.
+	void TickSimulate(float DeltaTime);
+	void TickCosmetic(float DeltaTime);
+
 	void StartMoving(const FVector& Forward, const FVector& InStartLocation);
 	void ApplyCorrection(const FVector& Forward);
 
 	bool IsFree() const { return bIsFree; }
 
+	// Client, set by UFGSignificanceManager. Lower significance sweeps in longer steps.
+	void SetSignificance(EFGSignificance InSignificance);
+
 	void Explode();
 	void MakeFree();
 
 private:
+	template <typename ElementType>
+	friend class TFGTickList;
+
+	int32 TickListIndex = INDEX_NONE;
+
 	void SetRocketVisibility(bool bVisible);
+	void SetRocketTickEnabled(bool bEnabled);
 
 	FCollisionQueryParams CachedCollisionQueryParams;
 
@@ -36,21 +52,49 @@ private:
 	UPROPERTY(EditAnywhere, Category = Debug)
 		bool bDebugDrawCorrection = true;
 
+	// The flight path only depends on time, so it is the same at any frame rate and can be evaluated at any step.
+	FVector GetFacingDirectionAtTime(float Time) const;
+	FVector GetLocationAtTime(float Time) const;
+
+	// Sweeps from the last simulated location to Time's location, returns true on a blocking hit.
+	bool SweepTo(float Time, FHitResult& OutHit);
+
 	FVector OriginalFacingDirection = FVector::ZeroVector;
 
+	// Current facing, for debug drawing.
 	FVector FacingRotationStart = FVector::ZeroVector;
 	FQuat FacingRotationCorrection = FQuat::Identity;
 
+	// Facing turns from CorrectionStartDirection towards FacingRotationCorrection from CorrectionTime on.
+	FQuat CorrectionStartDirection = FQuat::Identity;
+	float CorrectionTime = 0.0f;
+
 	FVector RocketStartLocation = FVector::ZeroVector;
+	FVector SimulatedLocation = FVector::ZeroVector;
 
 	float LifeTime = 2.0f;
-	float LifeTimeElapsed = 0.0f;
 
-	float DistanceMoved = 0.0f;
+	// Time since StartMoving, and how much of it has been swept in fixed steps.
+	float FlightTime = 0.0f;
+	float SimulatedTime = 0.0f;
 
 	UPROPERTY(EditAnywhere)
 	float MovementVelocity = 1300.0f;
 
+	// How fast the facing turns towards the server's correction, per second.
+	UPROPERTY(EditAnywhere)
+	float CorrectionRate = 0.9f;
+
+	UPROPERTY(EditAnywhere, Category = Collision, meta = (ClampMin = 0.0))
+	float CollisionRadius = 10.0f;
+
+	// Collision is swept in steps of this length regardless of frame rate.
+	UPROPERTY(EditAnywhere, Category = Collision, meta = (ClampMin = 0.001))
+	float SimulationStepTime = 1.0f / 120.0f;
+
+	EFGSignificance Significance{};
+	float SignificanceStepScale = 1.0f;
+
 	bool bIsFree = true;
 
 };
\ No newline at end of file
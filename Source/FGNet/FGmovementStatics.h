@@ -21,6 +21,9 @@ struct FFGFrameMovement
 
 	FVector FinalLocation = FVector::ZeroVector;
 
+	// How many collide-and-slide iterations the move needed.
+	int32 NumIterations = 0;
+
 private:
 
 	FVector MovementDelta = FVector::ZeroVector;
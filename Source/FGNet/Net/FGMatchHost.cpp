@@ -0,0 +1,242 @@
+#include "FGMatchHost.h"
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/World.h"
+#include "GameMapsSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Parse.h"
+#include "UObject/Package.h"
+#include "../FGNet.h"
+
+static TAutoConsoleVariable<float> CVarMatchesStatsInterval(
+	TEXT("FGNet.Matches.StatsInterval"),
+	60.0f,
+	TEXT("Seconds between per-match stats in the log. 0 disables."));
+
+static FAutoConsoleCommand MatchesCommand(
+	TEXT("FGNet.Matches"),
+	TEXT("Prints tick time and player count for every match hosted by this process."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		if (GEngine != nullptr)
+		{
+			if (const UFGMatchHost* MatchHost = GEngine->GetEngineSubsystem<UFGMatchHost>())
+				MatchHost->LogStats();
+		}
+	}));
+
+bool UFGMatchHost::ShouldCreateSubsystem(UObject* Outer) const
+{
+	int32 RequestedMatches = 1;
+	return IsRunningDedicatedServer()
+		&& FParse::Value(FCommandLine::Get(), TEXT("FGNetMatches="), RequestedMatches)
+		&& RequestedMatches > 1;
+}
+
+void UFGMatchHost::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FParse::Value(FCommandLine::Get(), TEXT("FGNetMatches="), NumRequestedMatches);
+
+	// The engine loads the first match after the subsystems are created, the rest start on the first tick.
+	TickHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UFGMatchHost::Tick));
+	WorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UFGMatchHost::OnWorldTickStart);
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UFGMatchHost::OnEndFrame);
+}
+
+void UFGMatchHost::Deinitialize()
+{
+	FTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+
+	for (UGameInstance* GameInstance : GameInstances)
+	{
+		if (GameInstance == nullptr)
+			continue;
+
+		if (UWorld* World = GameInstance->GetWorld())
+		{
+			World->DestroyWorld(true);
+			GEngine->DestroyWorldContext(World);
+		}
+
+		GameInstance->Shutdown();
+	}
+
+	GameInstances.Reset();
+	Matches.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UFGMatchHost::Tick(float DeltaTime)
+{
+	if (!bMatchesStarted)
+	{
+		StartMatches();
+	}
+
+	const float StatsInterval = CVarMatchesStatsInterval.GetValueOnGameThread();
+	const double Now = FPlatformTime::Seconds();
+	if (StatsInterval > 0.0f && Now - LastStatsTime >= StatsInterval)
+	{
+		LastStatsTime = Now;
+		LogStats();
+	}
+
+	return true;
+}
+
+void UFGMatchHost::StartMatches()
+{
+	const FWorldContext* PrimaryContext = nullptr;
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		if (Context.WorldType == EWorldType::Game && Context.World() != nullptr && Context.World()->GetNetDriver() != nullptr)
+		{
+			PrimaryContext = &Context;
+			break;
+		}
+	}
+
+	// Wait until the first match is loaded and listening, the others copy its map and options.
+	if (PrimaryContext == nullptr)
+		return;
+
+	bMatchesStarted = true;
+
+	const FURL& PrimaryURL = PrimaryContext->LastURL;
+
+	FMatch& PrimaryMatch = Matches.AddDefaulted_GetRef();
+	PrimaryMatch.World = PrimaryContext->World();
+	PrimaryMatch.Port = PrimaryURL.Port;
+
+	for (int32 Index = 1; Index < NumRequestedMatches; ++Index)
+	{
+		const int32 Port = PrimaryURL.Port + Index;
+		UGameInstance* GameInstance = StartMatch(PrimaryURL, Port, Index);
+		if (GameInstance == nullptr)
+			continue;
+
+		GameInstances.Add(GameInstance);
+
+		FMatch& Match = Matches.AddDefaulted_GetRef();
+		Match.World = GameInstance->GetWorld();
+		Match.Port = Port;
+	}
+
+	UE_LOG(LogFGNet, Log, TEXT("Hosting %d matches of %s on ports %d-%d"), Matches.Num(), *PrimaryURL.Map, PrimaryURL.Port, PrimaryURL.Port + NumRequestedMatches - 1);
+}
+
+UGameInstance* UFGMatchHost::StartMatch(const FURL& PrimaryURL, int32 Port, int32 Index)
+{
+	const FSoftClassPath GameInstanceClassName = GetDefault<UGameMapsSettings>()->GameInstanceClass;
+	UClass* GameInstanceClass = GameInstanceClassName.IsValid() ? LoadObject<UClass>(nullptr, *GameInstanceClassName.ToString()) : nullptr;
+	if (GameInstanceClass == nullptr)
+	{
+		GameInstanceClass = UGameInstance::StaticClass();
+	}
+
+	// A game instance of its own gives the match its own world context, and through it its own net driver.
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine, GameInstanceClass);
+	GameInstance->InitializeStandalone();
+
+	FWorldContext& WorldContext = *GameInstance->GetWorldContext();
+	WorldContext.PIEInstance = Index;
+	WorldContext.PIEPrefix = UWorld::BuildPIEPackagePrefix(Index);
+
+	// LoadMap of the same map name would find the first match's world in memory, so each match loads the map file
+	// into a package named like a PIE instance and gets its own world, levels and actors.
+	const FString InstancedMapName = UWorld::ConvertToPIEPackageName(PrimaryURL.Map, Index);
+	if (FindPackage(nullptr, *InstancedMapName) == nullptr)
+	{
+		UWorld::WorldTypePreLoadMap.FindOrAdd(FName(*InstancedMapName)) = EWorldType::Game;
+
+		UPackage* InstancedPackage = LoadPackage(CreatePackage(nullptr, *InstancedMapName), *PrimaryURL.Map, LOAD_None);
+		UWorld* InstancedWorld = InstancedPackage != nullptr ? UWorld::FindWorldInPackage(InstancedPackage) : nullptr;
+		if (InstancedWorld == nullptr)
+		{
+			UE_LOG(LogFGNet, Error, TEXT("Could not load %s as %s for the match on port %d"), *PrimaryURL.Map, *InstancedMapName, Port);
+			GameInstance->Shutdown();
+			return nullptr;
+		}
+
+		// Streaming levels get the same prefix, so they load as copies instead of the first match's sublevels.
+		InstancedWorld->StreamingLevelsPrefix = WorldContext.PIEPrefix;
+		for (ULevelStreaming* StreamingLevel : InstancedWorld->GetStreamingLevels())
+		{
+			StreamingLevel->RenameForPIE(Index);
+		}
+	}
+
+	FURL URL(PrimaryURL);
+	URL.Map = InstancedMapName;
+	URL.Port = Port;
+
+	FString Error;
+	if (!GEngine->LoadMap(WorldContext, URL, nullptr, Error))
+	{
+		UE_LOG(LogFGNet, Error, TEXT("Could not start match on port %d: %s"), Port, *Error);
+		GameInstance->Shutdown();
+		return nullptr;
+	}
+
+	return GameInstance;
+}
+
+UFGMatchHost::FMatch* UFGMatchHost::FindMatch(const UWorld* World)
+{
+	return Matches.FindByPredicate([World](const FMatch& Match) { return Match.World.Get() == World; });
+}
+
+void UFGMatchHost::OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaTime)
+{
+	// Worlds tick one after another, so a world's tick ends where the next one starts or at the end of the frame.
+	for (FMatch& Match : Matches)
+	{
+		if (Match.TickStartCycles != 0)
+			FinishTick(Match);
+	}
+
+	if (FMatch* Match = FindMatch(World))
+	{
+		Match->TickStartCycles = FPlatformTime::Cycles();
+	}
+}
+
+void UFGMatchHost::OnEndFrame()
+{
+	for (FMatch& Match : Matches)
+	{
+		if (Match.TickStartCycles != 0)
+			FinishTick(Match);
+	}
+}
+
+void UFGMatchHost::FinishTick(FMatch& Match)
+{
+	Match.LastTickMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles() - Match.TickStartCycles);
+	Match.AverageTickMs = FMath::Lerp(Match.AverageTickMs, Match.LastTickMs, 0.05f);
+	Match.MaxTickMs = FMath::Max(Match.MaxTickMs, Match.LastTickMs);
+	Match.TickStartCycles = 0;
+}
+
+void UFGMatchHost::LogStats() const
+{
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	UE_LOG(LogFGNet, Log, TEXT("%d matches, %.1f MB used, %.1f MB per match"), Matches.Num(),
+		MemoryStats.UsedPhysical / (1024.0 * 1024.0), MemoryStats.UsedPhysical / (1024.0 * 1024.0) / FMath::Max(Matches.Num(), 1));
+
+	for (const FMatch& Match : Matches)
+	{
+		const UWorld* World = Match.World.Get();
+		UE_LOG(LogFGNet, Log, TEXT("  Port %d: %d players, tick %.2f ms (average %.2f, max %.2f)"), Match.Port,
+			World != nullptr ? World->GetNumPlayerControllers() : 0, Match.LastTickMs, Match.AverageTickMs, Match.MaxTickMs);
+	}
+}
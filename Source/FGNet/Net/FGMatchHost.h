@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Subsystems/EngineSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "FGMatchHost.generated.h"
+
+class UGameInstance;
+class UWorld;
+
+/*
+ * Experimental, hosts several matches in one dedicated server process. Start the server with -FGNetMatches=N and it
+ * loads N - 1 more copies of its map, each under a PIE style instanced package name in its own world context with its
+ * own game instance, net driver and port (the first match's port + index). Matches share the engine, loaded assets
+ * and shaders, which is what makes small matches cheaper than one process each. Not yet checked with clients playing
+ * on more than one port at a time.
+ *
+ * World ticks stay on the game thread, one after another: UWorld::Tick switches GWorld and touches the garbage
+ * collector, the net driver and engine singletons that are not safe to use from two threads. The parallel work is
+ * inside each world (tick manager cosmetic pass, snapshot encoding), which runs on the task graph as usual.
+ *
+ * Each match's world tick time and player count are logged every FGNet.Matches.StatsInterval seconds. The
+ * FGNet.Matches command prints them on demand.
+ */
+UCLASS()
+class FGNET_API UFGMatchHost : public UEngineSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	int32 GetNumMatches() const { return Matches.Num(); }
+
+	void LogStats() const;
+
+private:
+	struct FMatch
+	{
+		TWeakObjectPtr<UWorld> World;
+		int32 Port = 0;
+		uint32 TickStartCycles = 0;
+		float LastTickMs = 0.0f;
+		float AverageTickMs = 0.0f;
+		float MaxTickMs = 0.0f;
+	};
+
+	bool Tick(float DeltaTime);
+	void StartMatches();
+	UGameInstance* StartMatch(const FURL& PrimaryURL, int32 Port, int32 Index);
+
+	FMatch* FindMatch(const UWorld* World);
+	void OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaTime);
+	void OnEndFrame();
+	void FinishTick(FMatch& Match);
+
+	TArray<FMatch> Matches;
+
+	// The first match's game instance belongs to the engine, these were created here.
+	UPROPERTY(Transient)
+	TArray<UGameInstance*> GameInstances;
+
+	FDelegateHandle TickHandle;
+	FDelegateHandle WorldTickStartHandle;
+	FDelegateHandle EndFrameHandle;
+
+	int32 NumRequestedMatches = 1;
+	double LastStatsTime = 0.0;
+	bool bMatchesStarted = false;
+};
@@ -0,0 +1,21 @@
+#include "FGNetDormancy.h"
+#include "GameFramework/Actor.h"
+#include "../FGNetStats.h"
+
+void FFGNetDormancy::Wake(AActor* Actor)
+{
+	if (Actor == nullptr || !Actor->HasAuthority() || Actor->NetDormancy <= DORM_Awake)
+		return;
+
+	Actor->SetNetDormancy(DORM_Awake);
+	INC_DWORD_STAT(STAT_FGNet_DormancyWakes);
+}
+
+void FFGNetDormancy::Sleep(AActor* Actor, ENetDormancy Dormancy)
+{
+	if (Actor == nullptr || !Actor->HasAuthority() || Actor->NetDormancy == Dormancy)
+		return;
+
+	Actor->SetNetDormancy(Dormancy);
+	INC_DWORD_STAT(STAT_FGNet_DormancySleeps);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Engine/EngineTypes.h"
+
+class AActor;
+
+/*
+ * Dormancy transitions for FGNet actors, so idle actors drop out of the net driver's consider list.
+ * Server only, no-ops on clients and for actors already in the requested state. Transitions show up in stat FGNet.
+ */
+struct FGNET_API FFGNetDormancy
+{
+	// Call before changing replicated state or calling a multicast RPC on a possibly dormant actor.
+	static void Wake(AActor* Actor);
+	static void Sleep(AActor* Actor, ENetDormancy Dormancy = DORM_DormantAll);
+};
@@ -0,0 +1,172 @@
+#include "FGSendScheduler.h"
+#include "Engine/NetConnection.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "../FGNetStats.h"
+
+static TAutoConsoleVariable<int32> CVarSendSchedulerBytesPerSecond(
+	TEXT("FGNet.SendScheduler.BytesPerSecond"),
+	0,
+	TEXT("Send budget per connection in bytes per second. 0 uses the connection's net speed."));
+
+static TAutoConsoleVariable<float> CVarSendSchedulerMaxBurstSeconds(
+	TEXT("FGNet.SendScheduler.MaxBurstSeconds"),
+	0.1f,
+	TEXT("How many seconds of unused budget a connection can save up."));
+
+static TAutoConsoleVariable<int32> CVarSendSchedulerMaxSendsPerTick(
+	TEXT("FGNet.SendScheduler.MaxSendsPerTick"),
+	64,
+	TEXT("Most updates a connection sends in one frame."));
+
+static TAutoConsoleVariable<float> CVarSendSchedulerStalenessWeight(
+	TEXT("FGNet.SendScheduler.StalenessWeight"),
+	10.0f,
+	TEXT("How much a pending update's priority grows per second it waits."));
+
+static TAutoConsoleVariable<float> CVarSendSchedulerDistanceFalloff(
+	TEXT("FGNet.SendScheduler.DistanceFalloff"),
+	5000.0f,
+	TEXT("Distance from the connection's view at which an update's priority is halved."));
+
+void UFGSendScheduler::Deinitialize()
+{
+	Connections.Empty();
+
+	Super::Deinitialize();
+}
+
+UFGSendScheduler* UFGSendScheduler::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject != nullptr ? WorldContextObject->GetWorld() : nullptr;
+	return World != nullptr ? World->GetSubsystem<UFGSendScheduler>() : nullptr;
+}
+
+void UFGSendScheduler::RequestSend(IFGScheduledSender* Sender, UNetConnection* Connection)
+{
+	check(Sender != nullptr);
+
+	if (Connection == nullptr)
+	{
+		Sender->ExecuteScheduledSend();
+		return;
+	}
+
+	FConnectionState& State = Connections.FindOrAdd(Connection);
+	State.Connection = Connection;
+
+	// Already waiting, keep the original request time so it does not lose its staleness.
+	for (const FPendingSend& PendingSend : State.PendingSends)
+	{
+		if (PendingSend.Sender == Sender)
+			return;
+	}
+
+	FPendingSend& PendingSend = State.PendingSends.AddDefaulted_GetRef();
+	PendingSend.Sender = Sender;
+	PendingSend.RequestTime = GetWorld()->GetRealTimeSeconds();
+}
+
+void UFGSendScheduler::CancelSend(IFGScheduledSender* Sender)
+{
+	for (TPair<UNetConnection*, FConnectionState>& Pair : Connections)
+	{
+		Pair.Value.PendingSends.RemoveAllSwap([Sender](const FPendingSend& PendingSend) { return PendingSend.Sender == Sender; }, false);
+	}
+}
+
+void UFGSendScheduler::Tick(float DeltaTime)
+{
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_SendScheduler);
+
+	const double CurrentTime = GetWorld()->GetRealTimeSeconds();
+
+	for (auto It = Connections.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().Connection.IsValid())
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		TickConnection(It.Value(), DeltaTime, CurrentTime);
+	}
+}
+
+void UFGSendScheduler::TickConnection(FConnectionState& State, float DeltaTime, double CurrentTime)
+{
+	UNetConnection* Connection = State.Connection.Get();
+
+	const int32 BytesPerSecondOverride = CVarSendSchedulerBytesPerSecond.GetValueOnGameThread();
+	const float BytesPerSecond = BytesPerSecondOverride > 0 ? static_cast<float>(BytesPerSecondOverride) : static_cast<float>(Connection->CurrentNetSpeed);
+	const float MaxAvailableBytes = BytesPerSecond * CVarSendSchedulerMaxBurstSeconds.GetValueOnGameThread();
+	State.AvailableBytes = FMath::Min(State.AvailableBytes + BytesPerSecond * DeltaTime, MaxAvailableBytes);
+
+	if (State.PendingSends.Num() == 0)
+		return;
+
+	// The connection is already saturated, waiting makes everything more important for next frame.
+	if (!Connection->IsNetReady(false))
+	{
+		INC_DWORD_STAT_BY(STAT_FGNet_DeferredSends, State.PendingSends.Num());
+		return;
+	}
+
+	FVector ViewLocation = FVector::ZeroVector;
+	if (APlayerController* PlayerController = Connection->PlayerController)
+	{
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	}
+
+	const float StalenessWeight = CVarSendSchedulerStalenessWeight.GetValueOnGameThread();
+	const float DistanceFalloff = FMath::Max(CVarSendSchedulerDistanceFalloff.GetValueOnGameThread(), 1.0f);
+
+	for (FPendingSend& PendingSend : State.PendingSends)
+	{
+		const float Staleness = static_cast<float>(CurrentTime - PendingSend.RequestTime);
+		const float Distance = FVector::Dist(ViewLocation, PendingSend.Sender->GetSendLocation());
+		PendingSend.Priority = PendingSend.Sender->GetSendImportance() * (1.0f + Staleness * StalenessWeight) / (1.0f + Distance / DistanceFalloff);
+	}
+
+	State.PendingSends.Sort([](const FPendingSend& A, const FPendingSend& B) { return A.Priority > B.Priority; });
+
+	const int32 MaxSends = CVarSendSchedulerMaxSendsPerTick.GetValueOnGameThread();
+	int32 NumSent = 0;
+
+	// The last send is allowed to overdraw the budget, the debt is paid back next frame.
+	while (NumSent < State.PendingSends.Num() && NumSent < MaxSends && State.AvailableBytes > 0.0f)
+	{
+		IFGScheduledSender* Sender = State.PendingSends[NumSent].Sender;
+		State.AvailableBytes -= static_cast<float>(Sender->GetEstimatedSendBytes());
+		NumSent++;
+
+		Sender->ExecuteScheduledSend();
+	}
+
+	State.PendingSends.RemoveAt(0, NumSent, false);
+
+	INC_DWORD_STAT_BY(STAT_FGNet_ScheduledSends, NumSent);
+	INC_DWORD_STAT_BY(STAT_FGNet_DeferredSends, State.PendingSends.Num());
+}
+
+bool UFGSendScheduler::IsTickable() const
+{
+	return Connections.Num() > 0;
+}
+
+ETickableTickType UFGSendScheduler::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+UWorld* UFGSendScheduler::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+TStatId UFGSendScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFGSendScheduler, STATGROUP_Tickables);
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "FGSendScheduler.generated.h"
+
+class UNetConnection;
+
+// Anything that sends gameplay updates through the send scheduler instead of sending on its own timer.
+class FGNET_API IFGScheduledSender
+{
+public:
+	virtual ~IFGScheduledSender() {}
+
+	// 1 is a regular update, higher goes first.
+	virtual float GetSendImportance() const { return 1.0f; }
+
+	// Updates far away from the connection's view go last.
+	virtual FVector GetSendLocation() const = 0;
+
+	// Rough size of the update on the wire, charged against the connection's byte budget.
+	virtual int32 GetEstimatedSendBytes() const = 0;
+
+	// Called on the game thread when the scheduler picks this sender, send the latest state here.
+	virtual void ExecuteScheduledSend() = 0;
+};
+
+/*
+ * Per connection send budget. Senders ask to send, and every frame each connection sends its most important pending
+ * updates until its byte budget or top-K limit is used up. Everything else waits and gets more important the longer it
+ * waits, so send rates drop smoothly when a connection saturates instead of everything degrading at once.
+ * Sends without a connection (standalone, or the listen server's own player) are executed right away.
+ */
+UCLASS()
+class FGNET_API UFGSendScheduler : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+
+	static UFGSendScheduler* Get(const UObject* WorldContextObject);
+
+	void RequestSend(IFGScheduledSender* Sender, UNetConnection* Connection);
+	void CancelSend(IFGScheduledSender* Sender);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+	// FTickableGameObject
+
+private:
+	struct FPendingSend
+	{
+		IFGScheduledSender* Sender = nullptr;
+		double RequestTime = 0.0;
+		float Priority = 0.0f;
+	};
+
+	struct FConnectionState
+	{
+		TWeakObjectPtr<UNetConnection> Connection;
+		TArray<FPendingSend> PendingSends;
+		float AvailableBytes = 0.0f;
+	};
+
+	void TickConnection(FConnectionState& State, float DeltaTime, double CurrentTime);
+
+	TMap<UNetConnection*, FConnectionState> Connections;
+};
@@ -0,0 +1,456 @@
+#include "FGSnapshotSubsystem.h"
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+#include "Engine/NetSerialization.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "../FGNetStats.h"
+#include "../FGNetTrace.h"
+#include "../Player/FGPlayer.h"
+
+static TAutoConsoleVariable<int32> CVarSnapshotEnabled(
+	TEXT("FGNet.Snapshot.Enabled"),
+	0,
+	TEXT("Server sends delta compressed world snapshots to clients."));
+
+static TAutoConsoleVariable<float> CVarSnapshotRate(
+	TEXT("FGNet.Snapshot.Rate"),
+	20.0f,
+	TEXT("World snapshots per second."));
+
+namespace FGSnapshot
+{
+	enum EFieldMask : uint32
+	{
+		Field_Location = 1 << 0,
+		Field_Yaw = 1 << 1,
+		Field_Type = 1 << 2,
+		Field_All = Field_Location | Field_Yaw | Field_Type
+	};
+
+	static constexpr uint32 NumFieldBits = 3;
+	static constexpr uint32 MaxEntityId = 1 << 16;
+
+	static uint32 GetChangedFields(const FFGSnapshotEntityState& State, const FFGSnapshotEntityState& Baseline)
+	{
+		uint32 Fields = 0;
+		if (State.Location != Baseline.Location)
+			Fields |= Field_Location;
+		if (State.Yaw != Baseline.Yaw)
+			Fields |= Field_Yaw;
+		if (State.Type != Baseline.Type)
+			Fields |= Field_Type;
+		return Fields;
+	}
+
+	static void SerializeEntityId(FArchive& Ar, uint16& EntityId)
+	{
+		uint32 Value = EntityId;
+		Ar.SerializeInt(Value, MaxEntityId);
+		EntityId = static_cast<uint16>(Value);
+	}
+
+	static void SerializeFields(FArchive& Ar, FFGSnapshotEntityState& State, uint32 Fields)
+	{
+		if (Fields & Field_Location)
+		{
+			SerializePackedVector<10, 24>(State.Location, Ar);
+		}
+
+		if (Fields & Field_Yaw)
+		{
+			Ar << State.Yaw;
+		}
+
+		if (Fields & Field_Type)
+		{
+			uint32 Type = static_cast<uint32>(State.Type);
+			// SerializeInt needs a range of at least two, players are the only type for now.
+			Ar.SerializeInt(Type, FMath::Max(static_cast<uint32>(EFGSnapshotEntityType::Num), 2u));
+			State.Type = static_cast<EFGSnapshotEntityType>(Type);
+		}
+	}
+}
+
+void UFGSnapshotSubsystem::Deinitialize()
+{
+	Entities.Empty();
+	Clients.Empty();
+	RemoteEntities.Empty();
+
+	Super::Deinitialize();
+}
+
+UFGSnapshotSubsystem* UFGSnapshotSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject != nullptr ? WorldContextObject->GetWorld() : nullptr;
+	return World != nullptr ? World->GetSubsystem<UFGSnapshotSubsystem>() : nullptr;
+}
+
+int32 UFGSnapshotSubsystem::RegisterEntity(AActor* Actor, EFGSnapshotEntityType Type)
+{
+	check(Actor != nullptr);
+
+	uint16 EntityId = 0;
+	if (FreeEntityIds.Num() > 0)
+	{
+		EntityId = FreeEntityIds.Pop(false);
+	}
+	else
+	{
+		if (!ensureMsgf(NextEntityId < MAX_uint16, TEXT("Out of snapshot entity ids")))
+			return INDEX_NONE;
+
+		EntityId = NextEntityId++;
+	}
+
+	Entities.Add({ Actor, EntityId, Type });
+	return EntityId;
+}
+
+void UFGSnapshotSubsystem::UnregisterEntity(int32 EntityId)
+{
+	const int32 Index = Entities.IndexOfByPredicate([EntityId](const FEntity& Entity) { return Entity.EntityId == EntityId; });
+	if (Index == INDEX_NONE)
+		return;
+
+	Entities.RemoveAtSwap(Index, 1, false);
+	FreeEntityIds.Add(static_cast<uint16>(EntityId));
+}
+
+void UFGSnapshotSubsystem::RegisterRemoteEntity(int32 EntityId, AActor* Actor)
+{
+	RemoteEntities.Add(static_cast<uint16>(EntityId), Actor);
+}
+
+void UFGSnapshotSubsystem::UnregisterRemoteEntity(int32 EntityId, AActor* Actor)
+{
+	// Ids are reused, the id may already belong to an actor that replicated in before this one ended play.
+	const TWeakObjectPtr<AActor>* RemoteActor = RemoteEntities.Find(static_cast<uint16>(EntityId));
+	if (RemoteActor != nullptr && (*RemoteActor == Actor || !RemoteActor->IsValid()))
+	{
+		RemoteEntities.Remove(static_cast<uint16>(EntityId));
+	}
+}
+
+void UFGSnapshotSubsystem::AckSnapshot(AFGPlayer* Player, int32 Sequence)
+{
+	for (FClient& Client : Clients)
+	{
+		if (Client.Player == Player)
+		{
+			// Acks are unreliable and can arrive out of order, only ever move forward.
+			if (Client.LastAckedSequence == INDEX_NONE || Sequence > Client.LastAckedSequence)
+			{
+				Client.LastAckedSequence = Sequence;
+			}
+			return;
+		}
+	}
+}
+
+void UFGSnapshotSubsystem::ReceiveSnapshot(AFGPlayer* Receiver, const TArray<uint8>& Data, int32 NumBits)
+{
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_SnapshotReceive);
+
+	FBitReader Reader(const_cast<uint8*>(Data.GetData()), NumBits);
+	if (!DecodeSnapshot(Reader, ReceivedSnapshots, DecodedSnapshot) || Reader.IsError())
+		return;
+
+	if (ReceivedSnapshots.Num() > 0 && DecodedSnapshot.Sequence <= ReceivedSnapshots.Back().Sequence)
+		return;
+
+	// Swap so the allocation of the snapshot falling out of the history is reused for the next decode.
+	Swap(ReceivedSnapshots.Push_GetRef(), DecodedSnapshot);
+	LastReceiveTime = GetWorld()->GetRealTimeSeconds();
+
+	Receiver->Server_AckWorldSnapshot(static_cast<int32>(ReceivedSnapshots.Back().Sequence));
+
+	ApplySnapshot(ReceivedSnapshots.Back());
+}
+
+void UFGSnapshotSubsystem::ApplySnapshot(const FFGWorldSnapshot& Snapshot)
+{
+	for (const FFGSnapshotEntityState& State : Snapshot.Entities)
+	{
+		if (State.Type != EFGSnapshotEntityType::Player)
+			continue;
+
+		const TWeakObjectPtr<AActor>* Actor = RemoteEntities.Find(State.EntityId);
+		AFGPlayer* Player = Actor != nullptr ? Cast<AFGPlayer>(Actor->Get()) : nullptr;
+		if (Player != nullptr && Player->IsSnapshotInterpolated())
+		{
+			Player->AddProxySnapshot(Snapshot.ServerTime, State.Location, FRotator::DecompressAxisFromShort(State.Yaw));
+		}
+	}
+}
+
+bool UFGSnapshotSubsystem::IsReceivingSnapshots() const
+{
+	return LastReceiveTime >= 0.0f && GetWorld()->GetRealTimeSeconds() - LastReceiveTime < 1.0f;
+}
+
+void UFGSnapshotSubsystem::Tick(float DeltaTime)
+{
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_SnapshotBuild);
+
+	SnapshotTimer -= DeltaTime;
+	if (SnapshotTimer > 0.0f)
+		return;
+
+	SnapshotTimer = FMath::Max(SnapshotTimer + 1.0f / FMath::Max(CVarSnapshotRate.GetValueOnGameThread(), 1.0f), 0.0f);
+
+	UpdateClients();
+	if (Clients.Num() == 0)
+		return;
+
+	BuildSnapshot(CurrentSnapshot);
+
+	// Every client reads the same snapshot and history and writes only its own buffer.
+	ParallelFor(Clients.Num(), [this](int32 ClientIndex)
+	{
+		FClient& Client = Clients[ClientIndex];
+		const FFGWorldSnapshot* Baseline = Client.LastAckedSequence != INDEX_NONE ? FindSnapshot(History, static_cast<uint32>(Client.LastAckedSequence)) : nullptr;
+
+		FBitWriter Writer(256, true);
+		EncodeSnapshot(Writer, CurrentSnapshot, Baseline);
+
+		Client.NumBits = static_cast<int32>(Writer.GetNumBits());
+		Client.Data = *Writer.GetBuffer();
+	}, Clients.Num() < 2);
+
+	uint32 NumBytes = 0;
+	for (FClient& Client : Clients)
+	{
+		NumBytes += Client.Data.Num();
+		FGNET_TRACE_NET_SEND(Client.Player.Get(), Client.Data.Num());
+		Client.Player->Client_ReceiveWorldSnapshot(Client.Data, Client.NumBits);
+	}
+
+	SET_DWORD_STAT(STAT_FGNet_SnapshotEntities, CurrentSnapshot.Entities.Num());
+	INC_DWORD_STAT_BY(STAT_FGNet_SnapshotBytes, NumBytes);
+
+	Swap(History.Push_GetRef(), CurrentSnapshot);
+}
+
+void UFGSnapshotSubsystem::BuildSnapshot(FFGWorldSnapshot& OutSnapshot)
+{
+	OutSnapshot.Sequence = NextSequence++;
+	OutSnapshot.ServerTime = GetWorld()->GetTimeSeconds();
+	OutSnapshot.Entities.Reset();
+
+	for (const FEntity& Entity : Entities)
+	{
+		const AActor* Actor = Entity.Actor.Get();
+		if (Actor == nullptr)
+			continue;
+
+		// Same quantization as SerializePackedVector<10, 24>, so unchanged entities compare equal.
+		const FVector Location = Actor->GetActorLocation();
+
+		FFGSnapshotEntityState& State = OutSnapshot.Entities.AddUninitialized_GetRef();
+		State.Location = FVector(FMath::RoundToFloat(Location.X * 10.0f), FMath::RoundToFloat(Location.Y * 10.0f), FMath::RoundToFloat(Location.Z * 10.0f)) / 10.0f;
+		State.EntityId = Entity.EntityId;
+		State.Yaw = FRotator::CompressAxisToShort(Actor->GetActorRotation().Yaw);
+		State.Type = Entity.Type;
+	}
+
+	OutSnapshot.Entities.Sort([](const FFGSnapshotEntityState& A, const FFGSnapshotEntityState& B) { return A.EntityId < B.EntityId; });
+}
+
+void UFGSnapshotSubsystem::UpdateClients()
+{
+	Clients.RemoveAllSwap([](const FClient& Client) { return !Client.Player.IsValid(); }, false);
+
+	for (const FEntity& Entity : Entities)
+	{
+		if (Entity.Type != EFGSnapshotEntityType::Player)
+			continue;
+
+		AFGPlayer* Player = Cast<AFGPlayer>(Entity.Actor.Get());
+		if (Player == nullptr || Player->IsLocallyControlled() || Player->GetNetConnection() == nullptr)
+			continue;
+
+		if (!Clients.ContainsByPredicate([Player](const FClient& Client) { return Client.Player == Player; }))
+		{
+			Clients.AddDefaulted_GetRef().Player = Player;
+		}
+	}
+}
+
+const FFGWorldSnapshot* UFGSnapshotSubsystem::FindSnapshot(const FSnapshotHistory& History, uint32 Sequence)
+{
+	if (History.Num() == 0)
+		return nullptr;
+
+	const uint32 Age = History.Back().Sequence - Sequence;
+	if (Age >= static_cast<uint32>(History.Num()))
+		return nullptr;
+
+	const FFGWorldSnapshot& Snapshot = History[History.Num() - 1 - Age];
+	return Snapshot.Sequence == Sequence ? &Snapshot : nullptr;
+}
+
+void UFGSnapshotSubsystem::EncodeSnapshot(FArchive& Ar, const FFGWorldSnapshot& Snapshot, const FFGWorldSnapshot* Baseline)
+{
+	using namespace FGSnapshot;
+
+	uint32 Sequence = Snapshot.Sequence;
+	Ar.SerializeIntPacked(Sequence);
+
+	uint8 bHasBaseline = Baseline != nullptr ? 1 : 0;
+	Ar.SerializeBits(&bHasBaseline, 1);
+	if (bHasBaseline)
+	{
+		uint32 BaselineAge = Snapshot.Sequence - Baseline->Sequence;
+		Ar.SerializeIntPacked(BaselineAge);
+	}
+
+	float ServerTime = Snapshot.ServerTime;
+	Ar << ServerTime;
+
+	// Both arrays are sorted by id, one merge walk finds changed, new and removed entities.
+	TArray<uint32, TInlineAllocator<64>> ChangedIndices;
+	TArray<uint32, TInlineAllocator<64>> ChangedFields;
+	TArray<uint16, TInlineAllocator<16>> RemovedIds;
+
+	const TArray<FFGSnapshotEntityState>& New = Snapshot.Entities;
+	static const TArray<FFGSnapshotEntityState> Empty;
+	const TArray<FFGSnapshotEntityState>& Old = Baseline != nullptr ? Baseline->Entities : Empty;
+
+	int32 NewIndex = 0;
+	int32 OldIndex = 0;
+	while (NewIndex < New.Num() || OldIndex < Old.Num())
+	{
+		if (OldIndex >= Old.Num() || (NewIndex < New.Num() && New[NewIndex].EntityId < Old[OldIndex].EntityId))
+		{
+			ChangedIndices.Add(NewIndex);
+			ChangedFields.Add(Field_All);
+			NewIndex++;
+		}
+		else if (NewIndex >= New.Num() || Old[OldIndex].EntityId < New[NewIndex].EntityId)
+		{
+			RemovedIds.Add(Old[OldIndex].EntityId);
+			OldIndex++;
+		}
+		else
+		{
+			const uint32 Fields = GetChangedFields(New[NewIndex], Old[OldIndex]);
+			if (Fields != 0)
+			{
+				ChangedIndices.Add(NewIndex);
+				ChangedFields.Add(Fields);
+			}
+			NewIndex++;
+			OldIndex++;
+		}
+	}
+
+	uint32 NumRemoved = RemovedIds.Num();
+	Ar.SerializeIntPacked(NumRemoved);
+	for (uint16 EntityId : RemovedIds)
+	{
+		SerializeEntityId(Ar, EntityId);
+	}
+
+	uint32 NumChanged = ChangedIndices.Num();
+	Ar.SerializeIntPacked(NumChanged);
+	for (int32 Index = 0; Index < ChangedIndices.Num(); ++Index)
+	{
+		FFGSnapshotEntityState State = New[ChangedIndices[Index]];
+		uint32 Fields = ChangedFields[Index];
+
+		SerializeEntityId(Ar, State.EntityId);
+		Ar.SerializeInt(Fields, 1 << NumFieldBits);
+		SerializeFields(Ar, State, Fields);
+	}
+}
+
+bool UFGSnapshotSubsystem::DecodeSnapshot(FArchive& Ar, const FSnapshotHistory& History, FFGWorldSnapshot& OutSnapshot)
+{
+	using namespace FGSnapshot;
+
+	uint32 Sequence = 0;
+	Ar.SerializeIntPacked(Sequence);
+
+	uint8 bHasBaseline = 0;
+	Ar.SerializeBits(&bHasBaseline, 1);
+
+	OutSnapshot.Entities.Reset();
+	if (bHasBaseline)
+	{
+		uint32 BaselineAge = 0;
+		Ar.SerializeIntPacked(BaselineAge);
+
+		const FFGWorldSnapshot* Baseline = FindSnapshot(History, Sequence - BaselineAge);
+		if (Baseline == nullptr)
+			return false;
+
+		OutSnapshot.Entities = Baseline->Entities;
+	}
+
+	OutSnapshot.Sequence = Sequence;
+	Ar << OutSnapshot.ServerTime;
+
+	TArray<FFGSnapshotEntityState>& Entities = OutSnapshot.Entities;
+
+	uint32 NumRemoved = 0;
+	Ar.SerializeIntPacked(NumRemoved);
+	for (uint32 Index = 0; Index < NumRemoved && !Ar.IsError(); ++Index)
+	{
+		uint16 EntityId = 0;
+		SerializeEntityId(Ar, EntityId);
+
+		const int32 EntityIndex = Algo::BinarySearchBy(Entities, EntityId, &FFGSnapshotEntityState::EntityId);
+		if (EntityIndex != INDEX_NONE)
+		{
+			Entities.RemoveAt(EntityIndex, 1, false);
+		}
+	}
+
+	uint32 NumChanged = 0;
+	Ar.SerializeIntPacked(NumChanged);
+	for (uint32 Index = 0; Index < NumChanged && !Ar.IsError(); ++Index)
+	{
+		uint16 EntityId = 0;
+		SerializeEntityId(Ar, EntityId);
+
+		uint32 Fields = 0;
+		Ar.SerializeInt(Fields, 1 << NumFieldBits);
+
+		int32 EntityIndex = Algo::LowerBoundBy(Entities, EntityId, &FFGSnapshotEntityState::EntityId);
+		if (EntityIndex == Entities.Num() || Entities[EntityIndex].EntityId != EntityId)
+		{
+			// New entities are always sent with every field.
+			Entities.InsertUninitialized(EntityIndex);
+			Entities[EntityIndex].EntityId = EntityId;
+		}
+
+		SerializeFields(Ar, Entities[EntityIndex], Fields);
+	}
+
+	return !Ar.IsError();
+}
+
+bool UFGSnapshotSubsystem::IsTickable() const
+{
+	const ENetMode NetMode = GetWorld()->GetNetMode();
+	return Entities.Num() > 0 && (NetMode == NM_DedicatedServer || NetMode == NM_ListenServer) && CVarSnapshotEnabled.GetValueOnGameThread() != 0;
+}
+
+ETickableTickType UFGSnapshotSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+UWorld* UFGSnapshotSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+TStatId UFGSnapshotSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFGSnapshotSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "../Containers/FGRingBuffer.h"
+#include "FGSnapshotSubsystem.generated.h"
+
+class AFGPlayer;
+class FArchive;
+
+enum class EFGSnapshotEntityType : uint8
+{
+	Player,
+	Num
+};
+
+// One entity in a world snapshot, quantized when it is written so deltas compare what goes on the wire.
+struct FFGSnapshotEntityState
+{
+	FVector Location;
+	uint16 EntityId;
+	uint16 Yaw;
+	EFGSnapshotEntityType Type;
+};
+
+struct FFGWorldSnapshot
+{
+	// Sorted by EntityId.
+	TArray<FFGSnapshotEntityState> Entities;
+	uint32 Sequence = 0;
+	float ServerTime = 0.0f;
+};
+
+/*
+ * Server side, writes every player into one contiguous snapshot each snapshot tick and sends every
+ * client only what changed since the last snapshot it acked, one field mask per changed entity. Encoding runs per client
+ * in parallel against the shared, read-only snapshot history.
+ * Client side, rebuilds the full snapshots from the deltas, acks them and feeds snapshot interpolated player proxies.
+ * Off unless FGNet.Snapshot.Enabled is set on the server.
+ */
+UCLASS()
+class FGNET_API UFGSnapshotSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	static constexpr uint32 HistorySize = 32;
+	typedef TFGRingBuffer<FFGWorldSnapshot, HistorySize> FSnapshotHistory;
+
+	virtual void Deinitialize() override;
+
+	static UFGSnapshotSubsystem* Get(const UObject* WorldContextObject);
+
+	// Server, returns the id to replicate to clients.
+	int32 RegisterEntity(AActor* Actor, EFGSnapshotEntityType Type);
+	void UnregisterEntity(int32 EntityId);
+
+	// Client, once the entity id has replicated.
+	void RegisterRemoteEntity(int32 EntityId, AActor* Actor);
+	void UnregisterRemoteEntity(int32 EntityId, AActor* Actor);
+
+	// Server, from the client's AFGPlayer.
+	void AckSnapshot(AFGPlayer* Player, int32 Sequence);
+
+	// Client, from the server via our own AFGPlayer.
+	void ReceiveSnapshot(AFGPlayer* Receiver, const TArray<uint8>& Data, int32 NumBits);
+
+	// Client, while snapshots are arriving they drive snapshot interpolated proxies instead of movement RPCs.
+	bool IsReceivingSnapshots() const;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+	// FTickableGameObject
+
+	static void EncodeSnapshot(FArchive& Ar, const FFGWorldSnapshot& Snapshot, const FFGWorldSnapshot* Baseline);
+	// Returns false if the baseline the snapshot was encoded against is not in History.
+	static bool DecodeSnapshot(FArchive& Ar, const FSnapshotHistory& History, FFGWorldSnapshot& OutSnapshot);
+	static const FFGWorldSnapshot* FindSnapshot(const FSnapshotHistory& History, uint32 Sequence);
+
+private:
+	struct FEntity
+	{
+		TWeakObjectPtr<AActor> Actor;
+		uint16 EntityId;
+		EFGSnapshotEntityType Type;
+	};
+
+	struct FClient
+	{
+		TWeakObjectPtr<AFGPlayer> Player;
+		int32 LastAckedSequence = INDEX_NONE;
+		TArray<uint8> Data;
+		int32 NumBits = 0;
+	};
+
+	void BuildSnapshot(FFGWorldSnapshot& OutSnapshot);
+	void UpdateClients();
+	void ApplySnapshot(const FFGWorldSnapshot& Snapshot);
+
+	// Server
+	TArray<FEntity> Entities;
+	TArray<uint16> FreeEntityIds;
+	TArray<FClient> Clients;
+	FSnapshotHistory History;
+	FFGWorldSnapshot CurrentSnapshot;
+	uint32 NextSequence = 0;
+	uint16 NextEntityId = 0;
+	float SnapshotTimer = 0.0f;
+
+	// Client
+	TMap<uint16, TWeakObjectPtr<AActor>> RemoteEntities;
+	FSnapshotHistory ReceivedSnapshots;
+	FFGWorldSnapshot DecodedSnapshot;
+	float LastReceiveTime = -1.0f;
+};
@@ -0,0 +1,190 @@
+#include "FGWarmPool.h"
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Fork.h"
+#include "Misc/Parse.h"
+#include "../FGNet.h"
+
+#if PLATFORM_LINUX
+#include <errno.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+bool UFGWarmPool::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if PLATFORM_LINUX
+	FString Path;
+	return IsRunningDedicatedServer() && FParse::Value(FCommandLine::Get(), TEXT("FGNetWarmPool="), Path);
+#else
+	return false;
+#endif
+}
+
+void UFGWarmPool::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FParse::Value(FCommandLine::Get(), TEXT("FGNetWarmPool="), SocketPath);
+
+	// The map is loaded after the subsystems are created, become the template on the first tick after that.
+	TickHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UFGWarmPool::Tick));
+}
+
+void UFGWarmPool::Deinitialize()
+{
+	FTicker::GetCoreTicker().RemoveTicker(TickHandle);
+
+	Super::Deinitialize();
+}
+
+bool UFGWarmPool::Tick(float DeltaTime)
+{
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		UWorld* World = Context.World();
+		if (Context.WorldType == EWorldType::Game && World != nullptr && World->GetNetDriver() != nullptr)
+		{
+			RunTemplate(World);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void UFGWarmPool::RunTemplate(UWorld* World)
+{
+#if PLATFORM_LINUX
+	// Children listen on their own ports, the template must not keep the map's port open for them to inherit.
+	GEngine->DestroyNamedNetDriver(World, World->GetNetDriver()->NetDriverName);
+	World->SetNetDriver(nullptr);
+
+	const int32 ListenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (ListenSocket < 0)
+	{
+		UE_LOG(LogFGNet, Fatal, TEXT("Warm pool: could not create control socket (%d)"), errno);
+		return;
+	}
+
+	sockaddr_un Address = {};
+	Address.sun_family = AF_UNIX;
+	FCStringAnsi::Strncpy(Address.sun_path, TCHAR_TO_UTF8(*SocketPath), sizeof(Address.sun_path));
+	unlink(Address.sun_path);
+
+	if (bind(ListenSocket, reinterpret_cast<sockaddr*>(&Address), sizeof(Address)) != 0 || listen(ListenSocket, 16) != 0)
+	{
+		UE_LOG(LogFGNet, Fatal, TEXT("Warm pool: could not listen on %s (%d)"), *SocketPath, errno);
+		close(ListenSocket);
+		return;
+	}
+
+	// Nobody waits for the children, let the kernel reap them.
+	signal(SIGCHLD, SIG_IGN);
+
+	UE_LOG(LogFGNet, Log, TEXT("Warm pool: %s loaded, waiting for matches on %s"), *World->GetMapName(), *SocketPath);
+	GLog->Flush();
+
+	while (true)
+	{
+		const int32 Connection = accept(ListenSocket, nullptr, nullptr);
+		if (Connection < 0)
+		{
+			if (errno == EINTR)
+				continue;
+
+			UE_LOG(LogFGNet, Error, TEXT("Warm pool: accept failed (%d)"), errno);
+			break;
+		}
+
+		ANSICHAR Request[256] = {};
+		const ssize_t RequestLength = read(Connection, Request, sizeof(Request) - 1);
+		const FString RequestLine = FString(UTF8_TO_TCHAR(Request)).TrimStartAndEnd();
+
+		FString Command;
+		FString Arguments;
+		if (RequestLength <= 0 || !RequestLine.Split(TEXT(" "), &Command, &Arguments))
+		{
+			Command = RequestLine;
+		}
+
+		FString Reply;
+		if (Command == TEXT("QUIT"))
+		{
+			close(Connection);
+			break;
+		}
+		else if (Command == TEXT("START"))
+		{
+			FString PortString;
+			FString NewMatchId;
+			const int32 Port = Arguments.Split(TEXT(" "), &PortString, &NewMatchId) ? FCString::Atoi(*PortString) : 0;
+
+			if (Port <= 0 || NewMatchId.IsEmpty())
+			{
+				Reply = TEXT("ERROR usage: START <port> <match id>\n");
+			}
+			else
+			{
+				const pid_t ChildPid = fork();
+				if (ChildPid == 0)
+				{
+					close(Connection);
+					close(ListenSocket);
+					StartForkedMatch(World, Port, NewMatchId.TrimStartAndEnd());
+					return;
+				}
+
+				Reply = ChildPid > 0 ? FString::Printf(TEXT("OK %d\n"), ChildPid) : FString::Printf(TEXT("ERROR fork failed (%d)\n"), errno);
+			}
+		}
+		else
+		{
+			Reply = TEXT("ERROR unknown command\n");
+		}
+
+		const FTCHARToUTF8 ReplyUTF8(*Reply);
+		if (write(Connection, ReplyUTF8.Get(), ReplyUTF8.Length()) < 0)
+		{
+			UE_LOG(LogFGNet, Warning, TEXT("Warm pool: could not reply to control connection (%d)"), errno);
+		}
+		close(Connection);
+	}
+
+	close(ListenSocket);
+	unlink(TCHAR_TO_UTF8(*SocketPath));
+	FPlatformMisc::RequestExit(false);
+#endif
+}
+
+void UFGWarmPool::StartForkedMatch(UWorld* World, int32 Port, const FString& InMatchId)
+{
+#if PLATFORM_LINUX
+	// Inherited from the template, the match itself waits for the processes it starts.
+	signal(SIGCHLD, SIG_DFL);
+#endif
+
+	FForkProcessHelper::SetIsForkedChildProcess();
+	FForkProcessHelper::OnForkingOccured();
+
+	MatchId = InMatchId;
+
+	// Every child would otherwise roll the same numbers as its siblings.
+	FMath::RandInit(FPlatformProcess::GetCurrentProcessId());
+
+	FURL URL(GEngine->GetWorldContextFromWorldChecked(World).LastURL);
+	URL.Port = Port;
+
+	if (!World->Listen(URL))
+	{
+		UE_LOG(LogFGNet, Fatal, TEXT("Warm pool: match %s could not listen on port %d"), *MatchId, Port);
+		return;
+	}
+
+	UE_LOG(LogFGNet, Log, TEXT("Warm pool: match %s started on port %d"), *MatchId, Port);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Subsystems/EngineSubsystem.h"
+#include "FGWarmPool.generated.h"
+
+class UWorld;
+
+/*
+ * Pre-forked warm server pool, Linux only. Start a dedicated server with -FGNetWarmPool=<socket path> and it
+ * initializes the engine and loads its map once, stops listening, then waits on an AF_UNIX control socket at that
+ * path. Every "START <port> <match id>" line forks a child that starts listening on the port and runs the match, the
+ * parent answers "OK <pid>" and waits for the next one. Children share the template's pages copy-on-write.
+ *
+ * Only the game thread survives fork(), so run the template with -nothreading -PostForkThreading and children start
+ * their worker threads after the fork.
+ */
+UCLASS()
+class FGNET_API UFGWarmPool : public UEngineSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	bool IsForkedMatch() const { return !MatchId.IsEmpty(); }
+	const FString& GetMatchId() const { return MatchId; }
+
+private:
+	bool Tick(float DeltaTime);
+
+	// Returns in forked children only, the template process serves the control socket until it is told to quit.
+	void RunTemplate(UWorld* World);
+	void StartForkedMatch(UWorld* World, int32 Port, const FString& InMatchId);
+
+	FDelegateHandle TickHandle;
+	FString SocketPath;
+	FString MatchId;
+};
@@ -0,0 +1,260 @@
+#include "FGBotManager.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerStart.h"
+#include "HAL/IConsoleManager.h"
+#include "FGPlayer.h"
+#include "../FGPickup.h"
+#include "../FGNet.h"
+#include "../FGNetStats.h"
+
+static TAutoConsoleVariable<float> CVarBotsDecisionRate(
+	TEXT("FGNet.Bots.DecisionRate"),
+	10.0f,
+	TEXT("How many times per second bots decide what to do."));
+
+static TAutoConsoleVariable<float> CVarBotsChaseDistance(
+	TEXT("FGNet.Bots.ChaseDistance"),
+	5000.0f,
+	TEXT("Bots with rockets chase players closer than this, and look for pickups otherwise."));
+
+static TAutoConsoleVariable<float> CVarBotsFireAngle(
+	TEXT("FGNet.Bots.FireAngle"),
+	10.0f,
+	TEXT("Bots fire when the player they chase is within this many degrees of their facing."));
+
+static FAutoConsoleCommandWithWorldAndArgs BotsAddCommand(
+	TEXT("FGNet.Bots.Add"),
+	TEXT("FGNet.Bots.Add <count>, spawns server side bots."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UFGBotManager* BotManager = UFGBotManager::Get(World))
+			BotManager->AddBots(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1);
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs BotsRemoveCommand(
+	TEXT("FGNet.Bots.Remove"),
+	TEXT("FGNet.Bots.Remove [count], removes server side bots, all of them without a count."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UFGBotManager* BotManager = UFGBotManager::Get(World))
+			BotManager->RemoveBots(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : BotManager->GetNumBots());
+	}));
+
+UFGBotManager* UFGBotManager::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject != nullptr ? WorldContextObject->GetWorld() : nullptr;
+	return World != nullptr ? World->GetSubsystem<UFGBotManager>() : nullptr;
+}
+
+void UFGBotManager::AddBots(int32 NumBots)
+{
+	UWorld* World = GetWorld();
+	const AGameModeBase* GameMode = World->GetAuthGameMode();
+	if (GameMode == nullptr)
+	{
+		UE_LOG(LogFGNet, Warning, TEXT("Bots can only be added on the server"));
+		return;
+	}
+
+	UClass* PawnClass = GameMode->DefaultPawnClass;
+	if (PawnClass == nullptr || !PawnClass->IsChildOf<AFGPlayer>())
+	{
+		UE_LOG(LogFGNet, Warning, TEXT("Bots need the game mode's default pawn to be an AFGPlayer"));
+		return;
+	}
+
+	TArray<const APlayerStart*> PlayerStarts;
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		PlayerStarts.Add(*It);
+	}
+
+	for (int32 Index = 0; Index < NumBots; ++Index)
+	{
+		FTransform SpawnTransform = FTransform::Identity;
+		if (PlayerStarts.Num() > 0)
+		{
+			SpawnTransform = PlayerStarts[(Bots.Num() + Index) % PlayerStarts.Num()]->GetActorTransform();
+		}
+
+		// No controller, the bot is driven from here.
+		AFGPlayer* Bot = World->SpawnActorDeferred<AFGPlayer>(PawnClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+		if (Bot == nullptr)
+			continue;
+
+		Bot->AutoPossessAI = EAutoPossessAI::Disabled;
+		Bot->SetIsBot(true);
+		Bot->FinishSpawning(SpawnTransform);
+		Bots.Add(Bot);
+	}
+
+	UE_LOG(LogFGNet, Log, TEXT("%d bots"), Bots.Num());
+}
+
+void UFGBotManager::RemoveBots(int32 NumBots)
+{
+	for (int32 Index = 0; Index < NumBots && Bots.Num() > 0; ++Index)
+	{
+		if (AFGPlayer* Bot = Bots.Pop(false))
+			Bot->Destroy();
+	}
+
+	UE_LOG(LogFGNet, Log, TEXT("%d bots"), Bots.Num());
+}
+
+void UFGBotManager::Tick(float DeltaTime)
+{
+	Bots.RemoveAllSwap([](const AFGPlayer* Bot) { return Bot == nullptr || Bot->IsPendingKill(); });
+	SET_DWORD_STAT(STAT_FGNet_Bots, Bots.Num());
+
+	DecisionTimer -= DeltaTime;
+	if (DecisionTimer > 0.0f)
+		return;
+
+	DecisionTimer = FMath::Max(DecisionTimer + 1.0f / FMath::Max(CVarBotsDecisionRate.GetValueOnGameThread(), 1.0f), 0.0f);
+	TickDecisions();
+}
+
+void UFGBotManager::TickDecisions()
+{
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_BotDecisions);
+
+	UWorld* World = GetWorld();
+
+	PlayerLocations.Reset();
+	BotViews.Reset();
+	DecidingBots.Reset();
+
+	// Bots are players too, remember where each one is in the player list so it does not chase itself.
+	for (TActorIterator<AFGPlayer> It(World); It; ++It)
+	{
+		AFGPlayer* Player = *It;
+		if (Player->IsBot())
+		{
+			FBotView& BotView = BotViews.AddDefaulted_GetRef();
+			BotView.Location = Player->GetActorLocation();
+			BotView.Forward = Player->GetActorForwardVector();
+			BotView.NumRockets = Player->GetNumRockets();
+			BotView.PlayerIndex = PlayerLocations.Num();
+			DecidingBots.Add(Player);
+		}
+
+		PlayerLocations.Add(Player->GetActorLocation());
+	}
+
+	PickupLocations.Reset();
+	for (TActorIterator<AFGPickup> It(World); It; ++It)
+	{
+		if (!It->IsPickedUp())
+			PickupLocations.Add(It->GetActorLocation());
+	}
+
+	Decisions.SetNum(BotViews.Num(), false);
+	NumDecisions++;
+
+	ParallelFor(BotViews.Num(), [this](int32 Index)
+	{
+		// Every bot wanders its own way, and changes its mind every few seconds.
+		const float WanderTurn = FMath::Sin(static_cast<float>(NumDecisions) * 0.05f + static_cast<float>(Index) * 1.7f);
+		Decisions[Index] = Decide(BotViews[Index], PlayerLocations, PickupLocations, WanderTurn);
+	}, BotViews.Num() < 16);
+
+	for (int32 Index = 0; Index < DecidingBots.Num(); ++Index)
+	{
+		AFGPlayer* Bot = DecidingBots[Index];
+		const FBotDecision& Decision = Decisions[Index];
+		Bot->SetInput(Decision.Forward, Decision.Turn, Decision.bBrake);
+
+		if (Decision.bFire)
+			Bot->FireRocket();
+	}
+}
+
+UFGBotManager::FBotDecision UFGBotManager::Decide(const FBotView& Bot, TArrayView<const FVector> OtherPlayerLocations, TArrayView<const FVector> AvailablePickupLocations, float WanderTurn)
+{
+	FBotDecision Decision;
+	Decision.Forward = 1.0f;
+
+	const bool bHasRockets = Bot.NumRockets > 0;
+	const float ChaseDistanceSq = FMath::Square(CVarBotsChaseDistance.GetValueOnAnyThread());
+
+	FVector Target = FVector::ZeroVector;
+	float TargetDistanceSq = BIG_NUMBER;
+	bool bHasTarget = false;
+	bool bTargetIsPlayer = false;
+
+	if (bHasRockets)
+	{
+		for (int32 Index = 0; Index < OtherPlayerLocations.Num(); ++Index)
+		{
+			const float DistanceSq = FVector::DistSquared(Bot.Location, OtherPlayerLocations[Index]);
+			if (Index != Bot.PlayerIndex && DistanceSq < TargetDistanceSq && DistanceSq < ChaseDistanceSq)
+			{
+				Target = OtherPlayerLocations[Index];
+				TargetDistanceSq = DistanceSq;
+				bHasTarget = true;
+				bTargetIsPlayer = true;
+			}
+		}
+	}
+
+	if (!bTargetIsPlayer)
+	{
+		for (const FVector& PickupLocation : AvailablePickupLocations)
+		{
+			const float DistanceSq = FVector::DistSquared(Bot.Location, PickupLocation);
+			if (DistanceSq < TargetDistanceSq)
+			{
+				Target = PickupLocation;
+				TargetDistanceSq = DistanceSq;
+				bHasTarget = true;
+			}
+		}
+	}
+
+	if (!bHasTarget)
+	{
+		Decision.Turn = WanderTurn;
+		return Decision;
+	}
+
+	const FVector ToTarget = (Target - Bot.Location).GetSafeNormal2D();
+	const FVector Forward = Bot.Forward.GetSafeNormal2D();
+	const float CosAngle = FVector::DotProduct(Forward, ToTarget);
+	const float Side = FVector::CrossProduct(Forward, ToTarget).Z;
+
+	Decision.Turn = CosAngle < 0.0f ? FMath::Sign(Side) : FMath::Clamp(Side * 4.0f, -1.0f, 1.0f);
+
+	// Turning is faster when slow, ease off when the target is behind.
+	if (CosAngle < 0.0f)
+	{
+		Decision.Forward = 0.3f;
+		Decision.bBrake = TargetDistanceSq < FMath::Square(1000.0f);
+	}
+
+	Decision.bFire = bTargetIsPlayer && CosAngle > FMath::Cos(FMath::DegreesToRadians(CVarBotsFireAngle.GetValueOnAnyThread()));
+	return Decision;
+}
+
+bool UFGBotManager::IsTickable() const
+{
+	return Bots.Num() > 0;
+}
+
+ETickableTickType UFGBotManager::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+UWorld* UFGBotManager::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+TStatId UFGBotManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFGBotManager, STATGROUP_Tickables);
+}
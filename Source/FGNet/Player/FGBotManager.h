@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "FGBotManager.generated.h"
+
+class AFGPlayer;
+
+/*
+ * Server side bots. A bot is an AFGPlayer pawn without a controller or connection that takes the same input, movement,
+ * pickup and fire paths as a local player, so it replicates exactly like one. FGNet.Bots.Add and FGNet.Bots.Remove
+ * change how many there are.
+ *
+ * Decisions run FGNet.Bots.DecisionRate times per second for all bots at once: the world is gathered on the game
+ * thread, every bot decides on a worker from that copy, and the input is applied back on the game thread.
+ * Bots with rockets chase the closest player and fire when facing it, bots without go for the closest pickup.
+ */
+UCLASS()
+class FGNET_API UFGBotManager : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	static UFGBotManager* Get(const UObject* WorldContextObject);
+
+	void AddBots(int32 NumBots);
+	void RemoveBots(int32 NumBots);
+
+	int32 GetNumBots() const { return Bots.Num(); }
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+	// FTickableGameObject
+
+private:
+	struct FBotView
+	{
+		FVector Location;
+		FVector Forward;
+		int32 NumRockets;
+		int32 PlayerIndex;
+	};
+
+	struct FBotDecision
+	{
+		float Forward = 0.0f;
+		float Turn = 0.0f;
+		bool bBrake = false;
+		bool bFire = false;
+	};
+
+	static FBotDecision Decide(const FBotView& Bot, TArrayView<const FVector> OtherPlayerLocations, TArrayView<const FVector> AvailablePickupLocations, float WanderTurn);
+
+	void TickDecisions();
+
+	UPROPERTY(Transient)
+	TArray<AFGPlayer*> Bots;
+
+	// Scratch, kept to avoid allocating every decision.
+	TArray<FBotView> BotViews;
+	TArray<AFGPlayer*> DecidingBots;
+	TArray<FBotDecision> Decisions;
+	TArray<FVector> PlayerLocations;
+	TArray<FVector> PickupLocations;
+
+	float DecisionTimer = 0.0f;
+	int32 NumDecisions = 0;
+};
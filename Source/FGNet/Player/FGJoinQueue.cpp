@@ -0,0 +1,105 @@
+#include "FGJoinQueue.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "FGPlayer.h"
+#include "../FGNet.h"
+#include "../FGNetStats.h"
+
+static TAutoConsoleVariable<float> CVarJoinBudgetMs(
+	TEXT("FGNet.Join.BudgetMs"),
+	1.0f,
+	TEXT("Milliseconds per frame spent setting up joining players. At least one step runs every frame."));
+
+UFGJoinQueue* UFGJoinQueue::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject != nullptr ? WorldContextObject->GetWorld() : nullptr;
+	return World != nullptr ? World->GetSubsystem<UFGJoinQueue>() : nullptr;
+}
+
+void UFGJoinQueue::Enqueue(AFGPlayer* Player)
+{
+	check(Player != nullptr);
+
+	FPendingJoin PendingJoin;
+	PendingJoin.Player = Player;
+	PendingJoin.EnqueueTime = FPlatformTime::Seconds();
+
+	// The listen server's own player goes first, nobody else is waiting on the host's screen.
+	if (Player->IsLocallyControlled())
+		Pending.Insert(PendingJoin, 0);
+	else
+		Pending.Add(PendingJoin);
+}
+
+void UFGJoinQueue::Remove(AFGPlayer* Player)
+{
+	Pending.RemoveAll([Player](const FPendingJoin& PendingJoin) { return PendingJoin.Player.Get() == Player; });
+}
+
+void UFGJoinQueue::Tick(float DeltaTime)
+{
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_JoinStep);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double EndTime = StartTime + CVarJoinBudgetMs.GetValueOnGameThread() / 1000.0;
+
+	for (FPendingJoin& PendingJoin : Pending)
+	{
+		PendingJoin.NumFrames++;
+	}
+
+	int32 Index = 0;
+	bool bBudgetLeft = true;
+	while (bBudgetLeft && Pending.Num() > 0)
+	{
+		if (Index >= Pending.Num())
+			Index = 0;
+
+		FPendingJoin& PendingJoin = Pending[Index];
+		AFGPlayer* Player = PendingJoin.Player.Get();
+
+		const double StepStartTime = FPlatformTime::Seconds();
+		const bool bMoreToDo = Player != nullptr && Player->SpawnNextRocket();
+		const double StepEndTime = FPlatformTime::Seconds();
+
+		INC_DWORD_STAT(STAT_FGNet_JoinSteps);
+		PendingJoin.SpawnSeconds += StepEndTime - StepStartTime;
+		bBudgetLeft = StepEndTime < EndTime;
+
+		if (bMoreToDo)
+		{
+			Index++;
+			continue;
+		}
+
+		if (Player != nullptr)
+		{
+			UE_LOG(LogFGNet, Verbose, TEXT("%s set up in %.2f ms over %d frames, %.2f ms after joining"), *Player->GetName(),
+				PendingJoin.SpawnSeconds * 1000.0, PendingJoin.NumFrames, (StepEndTime - PendingJoin.EnqueueTime) * 1000.0);
+		}
+
+		Pending.RemoveAt(Index);
+	}
+
+	SET_DWORD_STAT(STAT_FGNet_PendingJoins, Pending.Num());
+}
+
+bool UFGJoinQueue::IsTickable() const
+{
+	return Pending.Num() > 0;
+}
+
+ETickableTickType UFGJoinQueue::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+UWorld* UFGJoinQueue::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+TStatId UFGJoinQueue::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFGJoinQueue, STATGROUP_Tickables);
+}
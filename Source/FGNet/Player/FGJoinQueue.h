@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "FGJoinQueue.generated.h"
+
+class AFGPlayer;
+
+/*
+ * Server side, spreads the setup of joining players over frames. Each frame spawns rockets for queued players until
+ * FGNet.Join.BudgetMs is used up, one rocket per player per round so everyone gets their first rocket before anyone
+ * gets their last. The listen server's own player is set up first. Players can fire as soon as their first rocket
+ * exists, so a burst of joins costs a few frames of partial caches instead of one hitch and one replication burst.
+ */
+UCLASS()
+class FGNET_API UFGJoinQueue : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	static UFGJoinQueue* Get(const UObject* WorldContextObject);
+
+	void Enqueue(AFGPlayer* Player);
+	void Remove(AFGPlayer* Player);
+
+	int32 GetNumPending() const { return Pending.Num(); }
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+	// FTickableGameObject
+
+private:
+	struct FPendingJoin
+	{
+		TWeakObjectPtr<AFGPlayer> Player;
+		double EnqueueTime = 0.0;
+		double SpawnSeconds = 0.0;
+		int32 NumFrames = 0;
+	};
+
+	TArray<FPendingJoin> Pending;
+};
@@ -12,9 +12,20 @@
 #include "../Debug/UI/FGNetDebugWidget.h"
 #include "../FGRocket.h"
 #include "../FGPickup.h"
+#include "../Tick/FGTickManager.h"
+#include "../FGNet.h"
+#include "../FGNetStats.h"
+#include "../FGNetTrace.h"
+#include "../Debug/FGFlightRecorder.h"
+#include "../Net/FGSnapshotSubsystem.h"
+#include "../Net/FGNetDormancy.h"
+#include "FGJoinQueue.h"
+#include "../Tick/FGSignificanceManager.h"
+#include "Engine/ActorChannel.h"
+#include "Engine/NetConnection.h"
 
 const static float MaxMoveDeltaTime = 0.125f;
-#pragma optimize("", off)
+const static int32 RocketCacheSize = 8;
 
 AFGPlayer::AFGPlayer()
 {
@@ -35,6 +46,13 @@ AFGPlayer::AFGPlayer()
 	CameraComponent = CreateDefaultSubobject<UCameraComponent>(TEXT("CameraComponent"));
 	CameraComponent->SetupAttachment(SpringArmComponent);
 
+#if !FGNET_WITH_COSMETICS
+	// Blueprints still override these subobjects, so servers keep them but never run them.
+	SpringArmComponent->SetAutoActivate(false);
+	SpringArmComponent->PrimaryComponentTick.bStartWithTickEnabled = false;
+	CameraComponent->SetAutoActivate(false);
+#endif
+
 	MovementComponent = CreateDefaultSubobject<UFGMovementComponent>(TEXT("MovementComponent"));
 	
 	SetReplicateMovement(false);
@@ -46,36 +64,121 @@ void AFGPlayer::BeginPlay()
 
 	MovementComponent->SetUpdatedComponent(CollisionComponent);
 
+#if FGNET_WITH_COSMETICS
 	CreateDebugWidget();
 	if (DebugMenuInstance != nullptr)
 	{
 		DebugMenuInstance->SetVisibility(ESlateVisibility::Collapsed);
 	}
+#endif
 
 	SpawnRockets();
 
 	BP_OnNumRocketsChanged(NumRockets);
 
 	OriginalMeshOffset = MeshComponent->GetRelativeLocation();
+
+	if (UFGTickManager* TickManager = UFGTickManager::Get(this))
+	{
+		TickManager->RegisterPlayer(this);
+		SetActorTickEnabled(false);
+	}
+
+	if (HasAuthority())
+	{
+		if (UFGSnapshotSubsystem* SnapshotSubsystem = UFGSnapshotSubsystem::Get(this))
+		{
+			SnapshotEntityId = SnapshotSubsystem->RegisterEntity(this, EFGSnapshotEntityType::Player);
+		}
+	}
+}
+
+void AFGPlayer::PossessedBy(AController* NewController)
+{
+	Super::PossessedBy(NewController);
+
+	if (UFGTickManager* TickManager = UFGTickManager::Get(this))
+	{
+		TickManager->UpdateInputPrerequisite(this);
+	}
+}
+
+void AFGPlayer::UnPossessed()
+{
+	Super::UnPossessed();
+
+	if (UFGTickManager* TickManager = UFGTickManager::Get(this))
+	{
+		TickManager->UpdateInputPrerequisite(this);
+	}
+}
+
+void AFGPlayer::OnRep_Controller()
+{
+	Super::OnRep_Controller();
+
+	if (UFGTickManager* TickManager = UFGTickManager::Get(this))
+	{
+		TickManager->UpdateInputPrerequisite(this);
+	}
+}
+
+void AFGPlayer::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UFGTickManager* TickManager = UFGTickManager::Get(this))
+	{
+		TickManager->UnregisterPlayer(this);
+	}
+
+	if (UFGSendScheduler* SendScheduler = UFGSendScheduler::Get(this))
+	{
+		SendScheduler->CancelSend(this);
+	}
+
+	if (UFGJoinQueue* JoinQueue = UFGJoinQueue::Get(this))
+	{
+		JoinQueue->Remove(this);
+	}
+
+	if (SnapshotEntityId != INDEX_NONE)
+	{
+		if (UFGSnapshotSubsystem* SnapshotSubsystem = UFGSnapshotSubsystem::Get(this))
+		{
+			if (HasAuthority())
+				SnapshotSubsystem->UnregisterEntity(SnapshotEntityId);
+			else
+				SnapshotSubsystem->UnregisterRemoteEntity(SnapshotEntityId, this);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AFGPlayer::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	TickInput(DeltaTime);
+	TickSimulate(DeltaTime);
+	TickNetSend(DeltaTime);
+	TickCosmetic(DeltaTime);
+}
+
+void AFGPlayer::TickInput(float DeltaTime)
+{
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_PlayerInput);
+
 	FireCooldownElapsed -= DeltaTime;
 
 	if (!ensure(PlayerSettings != nullptr))
 		return;
 
-	FFGFrameMovement FrameMovement = MovementComponent->CreateFrameMovement();
+	const float Friction = IsBraking() ? PlayerSettings->BrakingFriction : PlayerSettings->Friction;
 
-	if (IsLocallyControlled())
+	if (IsLocallySimulated())
 	{
 		ClientTimeStamp += DeltaTime;
 
-		const float MaxVelocity = PlayerSettings->MaxVelocity;
-		const float Friction = IsBraking() ? PlayerSettings->BrakingFriction : PlayerSettings->Friction;
 		const float Alpha = FMath::Clamp(FMath::Abs(MovementVelocity / (PlayerSettings->MaxVelocity * 0.75f)), 0.0f, 1.0f);
 		const float TurnSpeed = FMath::InterpEaseOut(0.0f, PlayerSettings->TurnSpeedDefault, Alpha, 5.0f);
 		const float TurnDirection = MovementVelocity > 0.0f ? Turn : -Turn;
@@ -85,29 +188,226 @@ void AFGPlayer::Tick(float DeltaTime)
 		MovementComponent->SetFacingRotation(WantedFacingDirection, 10.5f);
 
 		AddMovementVelocity(DeltaTime);
-		MovementVelocity *= FMath::Pow(Friction, DeltaTime);
+	}
+
+	MovementVelocity *= FMath::Pow(Friction, DeltaTime);
+}
+
+void AFGPlayer::TickSimulate(float DeltaTime)
+{
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_PlayerSimulate);
+
+	if (PlayerSettings == nullptr)
+		return;
+
+	if (IsSnapshotInterpolated())
+	{
+		bApplyMeshSmoothing = false;
+		TickSnapshotInterpolation(DeltaTime);
+		return;
+	}
+
+	const bool bIsLocallySimulated = IsLocallySimulated();
+	bApplyMeshSmoothing = !bIsLocallySimulated && bPerformNetworkSmoothing && Significance == EFGSignificance::High;
+
+	if (!bIsLocallySimulated && Significance != EFGSignificance::High)
+	{
+		SkippedSimulateTime += DeltaTime;
+		NumSkippedSimulateFrames++;
 
+		if (NumSkippedSimulateFrames < (Significance == EFGSignificance::Medium ? 2 : 4))
+			return;
+
+		DeltaTime = SkippedSimulateTime;
+		SkippedSimulateTime = 0.0f;
+		NumSkippedSimulateFrames = 0;
+
+		// Corrections keep a low significance proxy out of walls, it is too small on screen to see it clip.
+		if (Significance == EFGSignificance::Low)
+		{
+			SetActorLocationAndRotation(GetActorLocation() + GetActorForwardVector() * MovementVelocity * DeltaTime, MovementComponent->GetFacingRotation(), false, nullptr, ETeleportType::None);
+			return;
+		}
+	}
+
+	FFGFrameMovement FrameMovement = MovementComponent->CreateFrameMovement();
+
+	if (bIsLocallySimulated)
+	{
 		MovementComponent->ApplyGravity();
-		FrameMovement.AddDelta(GetActorForwardVector() * MovementVelocity * DeltaTime);
-		MovementComponent->Move(FrameMovement);
+	}
+
+	FrameMovement.AddDelta(GetActorForwardVector() * MovementVelocity * DeltaTime);
+	MovementComponent->Move(FrameMovement);
+}
+
+void AFGPlayer::TickSnapshotInterpolation(float DeltaTime)
+{
+	if (ProxySnapshots.Num() == 0)
+		return;
 
-		Server_SendMovement(GetActorLocation(), ClientTimeStamp, Forward, GetActorRotation().Yaw);
+	const float InterpolationDelay = PlayerSettings->ProxyInterpolationDelay;
+	const float TargetRenderTime = ProxySnapshots.Back().Time - InterpolationDelay;
+
+	// Follow the sender's clock, drifting towards the target instead of jumping keeps motion smooth under jitter.
+	ProxyRenderTime += DeltaTime;
+	if (FMath::Abs(TargetRenderTime - ProxyRenderTime) > FMath::Max(InterpolationDelay, 0.1f))
+	{
+		ProxyRenderTime = TargetRenderTime;
 	}
 	else
 	{
-		const float Friction = IsBraking() ? PlayerSettings->BrakingFriction : PlayerSettings->Friction;
-		MovementVelocity *= FMath::Pow(Friction, DeltaTime);
-		FrameMovement.AddDelta(GetActorForwardVector() * MovementVelocity * DeltaTime);
-		MovementComponent->Move(FrameMovement);
+		ProxyRenderTime = FMath::FInterpTo(ProxyRenderTime, TargetRenderTime, DeltaTime, 2.0f);
+	}
+
+	// Keep one snapshot older than the render time to interpolate from.
+	while (ProxySnapshots.Num() > 2 && ProxySnapshots[1].Time <= ProxyRenderTime)
+	{
+		ProxySnapshots.PopFront();
+	}
+
+	FVector Location;
+	float SnapshotYaw;
+
+	const FFGProxySnapshot& From = ProxySnapshots.Front();
+	if (ProxySnapshots.Num() == 1 || ProxyRenderTime <= From.Time)
+	{
+		Location = From.Location;
+		SnapshotYaw = From.Yaw;
+	}
+	else if (ProxyRenderTime <= ProxySnapshots[1].Time)
+	{
+		const FFGProxySnapshot& To = ProxySnapshots[1];
+		const float Alpha = (ProxyRenderTime - From.Time) / FMath::Max(To.Time - From.Time, KINDA_SMALL_NUMBER);
+		Location = FMath::Lerp(From.Location, To.Location, Alpha);
+		SnapshotYaw = FMath::Lerp(From.Yaw, From.Yaw + FMath::FindDeltaAngleDegrees(From.Yaw, To.Yaw), Alpha);
+	}
+	else
+	{
+		// Past the newest snapshot, keep going along the last segment for a little while.
+		const FFGProxySnapshot& To = ProxySnapshots[1];
+		const float ExtrapolationTime = FMath::Min(ProxyRenderTime - To.Time, PlayerSettings->ProxyMaxExtrapolationTime);
+		const FVector Velocity = (To.Location - From.Location) / FMath::Max(To.Time - From.Time, KINDA_SMALL_NUMBER);
+		Location = To.Location + Velocity * ExtrapolationTime;
+		SnapshotYaw = To.Yaw;
+	}
+
+	const FRotator Rotation(0.0f, SnapshotYaw, 0.0f);
+	MovementComponent->SetFacingRotation(Rotation);
+	SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+}
 
-		if (bPerformNetworkSmoothing)
+void AFGPlayer::SetProxyMode(EFGProxyMode InProxyMode)
+{
+	if (ProxyMode == InProxyMode)
+		return;
+
+	ProxyMode = InProxyMode;
+	ProxySnapshots.Reset();
+
+	// Switching in either direction starts from where the proxy is now.
+	MeshComponent->SetRelativeLocation(OriginalMeshOffset, false, nullptr, ETeleportType::TeleportPhysics);
+	MovementComponent->InvalidateFloor();
+	MovementVelocity = 0.0f;
+}
+
+void AFGPlayer::AddProxySnapshot(float Time, const FVector& Location, float SnapshotYaw)
+{
+	if (ProxySnapshots.Num() > 0 && Time <= ProxySnapshots.Back().Time)
+	{
+		// Far behind is not a late snapshot but a different clock, start over on the new one.
+		if (ProxySnapshots.Back().Time - Time < 1.0f)
+			return;
+
+		ProxySnapshots.Reset();
+	}
+
+	if (ProxySnapshots.Num() == 0 && PlayerSettings != nullptr)
+	{
+		ProxyRenderTime = Time - PlayerSettings->ProxyInterpolationDelay;
+	}
+
+	ProxySnapshots.Push({ Time, Location, SnapshotYaw });
+}
+
+bool AFGPlayer::IsSnapshotInterpolated() const
+{
+	return ProxyMode == EFGProxyMode::SnapshotInterpolation && GetNetMode() == NM_Client && !IsLocallyControlled();
+}
+
+void AFGPlayer::TickNetSend(float DeltaTime)
+{
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_PlayerNetSend);
+
+	if (PlayerSettings == nullptr)
+		return;
+
+	if (IsLocallySimulated())
+	{
+		// Only a client's uplink is budgeted, the listen server's own player sends right away.
+		UFGSendScheduler* SendScheduler = UFGSendScheduler::Get(this);
+		if (SendScheduler != nullptr && !HasAuthority())
+		{
+			SendScheduler->RequestSend(this, GetNetConnection());
+		}
+		else
 		{
-			const FVector NewRelativeLocation = FMath::VInterpTo(MeshComponent->GetRelativeLocation(), OriginalMeshOffset, LastCorrectionDelta, 1.75f);
-			MeshComponent->SetRelativeLocation(NewRelativeLocation, false, nullptr, ETeleportType::TeleportPhysics);
+			ExecuteScheduledSend();
 		}
 	}
 }
 
+float AFGPlayer::GetSendImportance() const
+{
+	// Our own movement is what everyone else sees of us, it goes before any value replication.
+	return 4.0f;
+}
+
+FVector AFGPlayer::GetSendLocation() const
+{
+	return GetActorLocation();
+}
+
+int32 AFGPlayer::GetEstimatedSendBytes() const
+{
+	// RPC header, location, time stamp, forward and yaw.
+	return 32;
+}
+
+void AFGPlayer::ExecuteScheduledSend()
+{
+	// Always the latest state, a send that waited a few frames must not send what was current when it was requested.
+	FGNET_TRACE_NET_SEND(this, GetEstimatedSendBytes());
+	Server_SendMovement(GetActorLocation(), ClientTimeStamp, Forward, GetActorRotation().Yaw);
+}
+
+void AFGPlayer::TickCosmetic(float DeltaTime)
+{
+#if FGNET_WITH_COSMETICS
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_PlayerCosmetic);
+
+	FFGPlayerCosmeticState CosmeticState;
+	if (ComputeCosmetic(DeltaTime, 0.0f, CosmeticState))
+	{
+		ApplyCosmetic(CosmeticState);
+	}
+#endif
+}
+
+bool AFGPlayer::ComputeCosmetic(float DeltaTime, float TimeSeconds, FFGPlayerCosmeticState& OutState) const
+{
+	if (!bApplyMeshSmoothing)
+		return false;
+
+	OutState.MeshRelativeLocation = FMath::VInterpTo(MeshComponent->GetRelativeLocation(), OriginalMeshOffset, LastCorrectionDelta, 1.75f);
+	return true;
+}
+
+void AFGPlayer::ApplyCosmetic(const FFGPlayerCosmeticState& State)
+{
+	MeshComponent->SetRelativeLocation(State.MeshRelativeLocation, false, nullptr, ETeleportType::TeleportPhysics);
+}
+
 void AFGPlayer::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
 	Super::SetupPlayerInputComponent(PlayerInputComponent);
@@ -135,26 +435,39 @@ int32 AFGPlayer::GetPing() const
 
 void AFGPlayer::SpawnRockets()
 {
-	if (HasAuthority() && RocketClass != nullptr)
+	if (!HasAuthority() || RocketClass == nullptr)
+		return;
+
+	if (UFGJoinQueue* JoinQueue = UFGJoinQueue::Get(this))
 	{
-		const int32 RocketCache = 8;
+		JoinQueue->Enqueue(this);
+		return;
+	}
 
-		for (int32 Index = 0; Index < RocketCache; ++Index)
-		{
-			FActorSpawnParameters SpawnParams;
-			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-			SpawnParams.ObjectFlags = RF_Transient;
-			SpawnParams.Instigator = this;
-			SpawnParams.Owner = this;
-			AFGRocket* NewRocketInstance = GetWorld()->SpawnActor<AFGRocket>(RocketClass, GetActorLocation(), GetActorRotation(), SpawnParams);
-			RocketInstances.Add(NewRocketInstance);
-		}
+	while (SpawnNextRocket())
+	{
 	}
 }
 
+bool AFGPlayer::SpawnNextRocket()
+{
+	if (RocketClass == nullptr || RocketInstances.Num() >= RocketCacheSize)
+		return false;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	SpawnParams.ObjectFlags = RF_Transient;
+	SpawnParams.Instigator = this;
+	SpawnParams.Owner = this;
+	AFGRocket* NewRocketInstance = GetWorld()->SpawnActor<AFGRocket>(RocketClass, GetActorLocation(), GetActorRotation(), SpawnParams);
+	RocketInstances.Add(NewRocketInstance);
+
+	return RocketInstances.Num() < RocketCacheSize;
+}
+
 void AFGPlayer::OnPickup(AFGPickup* Pickup)
 {
-	if (IsLocallyControlled())
+	if (IsLocallySimulated())
 		Server_OnPickup(Pickup);
 }
 
@@ -166,17 +479,75 @@ void AFGPlayer::Client_OnPickupRockets_Implementation(int32 PickedUpRockets)
 
 void AFGPlayer::Server_OnPickup_Implementation(AFGPickup* Pickup)
 {
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_ServerOnPickup);
+
+	if (Pickup == nullptr || PlayerSettings == nullptr)
+		return;
+
+	const float PickupDistanceSq = FVector::DistSquared(Pickup->GetActorLocation(), GetActorLocation());
+	if (PickupDistanceSq > FMath::Square(PlayerSettings->MaxPickupDistance))
+	{
+		ServerMoveValidation.NumRejectedPickups++;
+		INC_DWORD_STAT(STAT_FGNet_RejectedPickups);
+		UE_LOG(LogFGNet, Warning, TEXT("%s: rejected pickup %s at %.0f units (%d rejected so far)"), *GetName(), *Pickup->GetName(), FMath::Sqrt(PickupDistanceSq), ServerMoveValidation.NumRejectedPickups);
+		return;
+	}
+
+	// Overlaps run on every machine, so the server's pickup may already show as taken by this very player.
+	// What matters is that its rockets are only handed out once until it respawns.
+	if (Pickup->IsClaimed())
+	{
+		ServerMoveValidation.NumRejectedPickups++;
+		INC_DWORD_STAT(STAT_FGNet_RejectedPickups);
+		UE_LOG(LogFGNet, Warning, TEXT("%s: rejected pickup %s, already taken (%d rejected so far)"), *GetName(), *Pickup->GetName(), ServerMoveValidation.NumRejectedPickups);
+		return;
+	}
+
+	Pickup->Claim();
+	FFGNetDormancy::Wake(this);
 	ServerNumRockets += Pickup->NumRockets;
 	Client_OnPickupRockets(Pickup->NumRockets);
 }
 
 void AFGPlayer::Server_SendYaw_Implementation(float NewYaw)
 {
+	FFGNetDormancy::Wake(this);
 	ReplicatedYaw = NewYaw;
 }
 
+void AFGPlayer::SetIsBot(bool bInIsBot)
+{
+	check(HasAuthority());
+	bIsBot = bInIsBot;
+	Yaw = GetActorRotation().Yaw;
+}
+
+void AFGPlayer::SetInput(float InForward, float InTurn, bool bInBrake)
+{
+	Forward = InForward;
+	Turn = InTurn;
+	bBrake = bInBrake;
+}
+
+void AFGPlayer::SetSignificance(EFGSignificance InSignificance)
+{
+	if (Significance == InSignificance)
+		return;
+
+	// Smoothing stops below High, put the mesh back where it belongs.
+	if (Significance == EFGSignificance::High)
+	{
+		MeshComponent->SetRelativeLocation(OriginalMeshOffset, false, nullptr, ETeleportType::TeleportPhysics);
+	}
+
+	Significance = InSignificance;
+	SkippedSimulateTime = 0.0f;
+	NumSkippedSimulateFrames = 0;
+}
+
 void AFGPlayer::ShowDebugMenu()
 {
+#if FGNET_WITH_COSMETICS
 	CreateDebugWidget();
 
 	if (DebugMenuInstance == nullptr)
@@ -184,19 +555,23 @@ void AFGPlayer::ShowDebugMenu()
 
 	DebugMenuInstance->SetVisibility(ESlateVisibility::Visible);
 	DebugMenuInstance->BP_OnShowWidget();
+#endif
 }
 
 void AFGPlayer::HideDebugMenu()
 {
+#if FGNET_WITH_COSMETICS
 	if (DebugMenuInstance == nullptr)
 		return;
 
 	DebugMenuInstance->SetVisibility(ESlateVisibility::Collapsed);
 	DebugMenuInstance->BP_OnHideWidget();
+#endif
 }
 
 void AFGPlayer::Server_SendLocation_Implementation(const FVector& LocationToSend, const FRotator& RotationToSend)
 {
+	FFGNetDormancy::Wake(this);
 	Multicast_SendLocation(LocationToSend, RotationToSend);
 }
 
@@ -216,7 +591,7 @@ int32 AFGPlayer::GetNumActiveRockets() const
 	int32 NumActive = 0;
 	for (AFGRocket* Rocket : RocketInstances)
 	{
-		if (!Rocket->IsFree())
+		if (Rocket != nullptr && !Rocket->IsFree())
 			NumActive++;
 	}
 
@@ -269,9 +644,10 @@ void AFGPlayer::FireRocket()
 	if (GetNumActiveRockets() >= MaxActiveRockets)
 		return;
 
+	// Rockets are spawned over a few frames after joining, there may not be one yet.
 	AFGRocket* NewRocket = GetFreeRocket();
 
-	if (!ensure(NewRocket != nullptr))
+	if (NewRocket == nullptr)
 		return;
 
 	FireCooldownElapsed = PlayerSettings->FireCooldown;
@@ -293,6 +669,11 @@ void AFGPlayer::FireRocket()
 
 void AFGPlayer::Server_FireRocket_Implementation(AFGRocket* NewRocket, const FVector& RocketStartLocation, const FRotator& FacingRotation)
 {
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_ServerFireRocket);
+
+	if (NewRocket == nullptr)
+		return;
+
 	if ((ServerNumRockets - 1) < 0 && !bUnlimitedRockets)
 	{
 		Client_RemoveRocket(NewRocket);
@@ -301,6 +682,7 @@ void AFGPlayer::Server_FireRocket_Implementation(AFGRocket* NewRocket, const FVe
 	{
 		const float DeltaYaw = FMath::FindDeltaAngleDegrees(FacingRotation.Yaw, GetActorForwardVector().Rotation().Yaw) * 0.5f;
 		const FRotator NewFacingRotation = FacingRotation + FRotator(0.0f, DeltaYaw, 0.0f);
+		FFGNetDormancy::Wake(this);
 		ServerNumRockets--;
 		Multicast_FireRocket(NewRocket, RocketStartLocation, NewFacingRotation);
 	}
@@ -308,6 +690,8 @@ void AFGPlayer::Server_FireRocket_Implementation(AFGRocket* NewRocket, const FVe
 
 void AFGPlayer::Multicast_FireRocket_Implementation(AFGRocket* NewRocket, const FVector& RocketStartLocation, const FRotator& FacingRotation)
 {
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_MulticastFireRocket);
+
 	if (!ensure(NewRocket != nullptr))
 		return;
 
@@ -324,7 +708,8 @@ void AFGPlayer::Multicast_FireRocket_Implementation(AFGRocket* NewRocket, const
 
 void AFGPlayer::Client_RemoveRocket_Implementation(AFGRocket* RocketToRemove)
 {
-	RocketToRemove->MakeFree();
+	if (RocketToRemove != nullptr)
+		RocketToRemove->MakeFree();
 }
 
 void AFGPlayer::Cheat_IncreaseRockets(int32 InNumRockets)
@@ -335,6 +720,7 @@ void AFGPlayer::Cheat_IncreaseRockets(int32 InNumRockets)
 
 void AFGPlayer::CreateDebugWidget()
 {
+#if FGNET_WITH_COSMETICS
 	if (DebugMenuClass == nullptr)
 		return;
 
@@ -346,6 +732,7 @@ void AFGPlayer::CreateDebugWidget()
 		DebugMenuInstance = CreateWidget<UFGNetDebugWidget>(GetWorld(), DebugMenuClass);
 		DebugMenuInstance->AddToViewport();
 	}
+#endif
 }
 
 AFGRocket* AFGPlayer::GetFreeRocket() const
@@ -364,7 +751,21 @@ AFGRocket* AFGPlayer::GetFreeRocket() const
 
 void AFGPlayer::Multicast_SendMovement_Implementation(const FVector& InClientLocation, float TimeStamp, float ClientForward, float ClientYaw)
 {
-	if (!IsLocallyControlled())
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_MulticastSendMovement);
+
+	if (IsSnapshotInterpolated())
+	{
+		// World snapshots are on the server's clock, mixing in movement RPCs would mix timelines.
+		const UFGSnapshotSubsystem* SnapshotSubsystem = UFGSnapshotSubsystem::Get(this);
+		if (SnapshotSubsystem == nullptr || !SnapshotSubsystem->IsReceivingSnapshots())
+		{
+			ClientTimeStamp = TimeStamp;
+			AddProxySnapshot(TimeStamp, InClientLocation, ClientYaw);
+		}
+		return;
+	}
+
+	if (!IsLocallySimulated())
 	{
 		Forward = ClientForward;
 		const float DeltaTime = FMath::Min(TimeStamp - ClientTimeStamp, MaxMoveDeltaTime);
@@ -376,7 +777,11 @@ void AFGPlayer::Multicast_SendMovement_Implementation(const FVector& InClientLoc
 
 		if (DeltaDiff.SizeSquared() > FMath::Square(40.0f))
 		{
-			if (bPerformNetworkSmoothing)
+			FGNET_TRACE_CORRECTION(this, DeltaDiff.Size());
+			UFGFlightRecorder::RecordCorrection(this, DeltaDiff.Size());
+			MovementComponent->InvalidateFloor();
+
+			if (bPerformNetworkSmoothing && Significance == EFGSignificance::High)
 			{
 				const FScopedPreventAttachedComponentMove PreventMeshMove(MeshComponent);
 				MovementComponent->UpdatedComponent->SetWorldLocation(InClientLocation, false, nullptr, ETeleportType::TeleportPhysics);
@@ -390,9 +795,147 @@ void AFGPlayer::Multicast_SendMovement_Implementation(const FVector& InClientLoc
 	}
 }
 
+void AFGPlayer::Client_ReceiveWorldSnapshot_Implementation(const TArray<uint8>& SnapshotData, int32 NumBits)
+{
+	if (NumBits <= 0 || NumBits > SnapshotData.Num() * 8)
+		return;
+
+	if (UFGSnapshotSubsystem* SnapshotSubsystem = UFGSnapshotSubsystem::Get(this))
+	{
+		SnapshotSubsystem->ReceiveSnapshot(this, SnapshotData, NumBits);
+	}
+}
+
+void AFGPlayer::Server_AckWorldSnapshot_Implementation(int32 Sequence)
+{
+	if (UFGSnapshotSubsystem* SnapshotSubsystem = UFGSnapshotSubsystem::Get(this))
+	{
+		SnapshotSubsystem->AckSnapshot(this, Sequence);
+	}
+}
+
+void AFGPlayer::OnRep_SnapshotEntityId()
+{
+	if (UFGSnapshotSubsystem* SnapshotSubsystem = UFGSnapshotSubsystem::Get(this))
+	{
+		SnapshotSubsystem->RegisterRemoteEntity(SnapshotEntityId, this);
+	}
+}
+
 void AFGPlayer::Server_SendMovement_Implementation(const FVector& ClientLocation, float TimeStamp, float ClientForward, float ClientYaw)
 {
-	Multicast_SendMovement(ClientLocation, TimeStamp, ClientForward, ClientYaw);
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_ServerSendMovement);
+
+	FVector ValidatedLocation = ClientLocation;
+	const EFGServerMoveResult MoveResult = ValidateClientMove(ValidatedLocation, TimeStamp);
+
+	if (MoveResult == EFGServerMoveResult::Rejected)
+		return;
+
+	if (MoveResult == EFGServerMoveResult::Clamped)
+	{
+		FGNET_TRACE_CORRECTION(this, FVector::Dist(ClientLocation, ValidatedLocation));
+		UFGFlightRecorder::RecordCorrection(this, FVector::Dist(ClientLocation, ValidatedLocation));
+		Client_CorrectLocation(ValidatedLocation);
+	}
+
+	const float ServerTime = GetWorld()->GetTimeSeconds();
+	const bool bIsStationary = ClientForward == 0.0f && ValidatedLocation.Equals(LastRelayedLocation, 1.0f) && FMath::IsNearlyEqual(ClientYaw, LastRelayedYaw, 0.5f);
+
+	if (!bIsStationary)
+	{
+		StationarySince = ServerTime;
+		FFGNetDormancy::Wake(this);
+	}
+	else if (PlayerSettings != nullptr && ServerTime - StationarySince > PlayerSettings->NetDormancyDelay)
+	{
+		// Remotes already have our final position, see GetNetDormancy for why the owner's channel stays open.
+		FFGNetDormancy::Sleep(this, DORM_DormantPartial);
+		return;
+	}
+
+	LastRelayedLocation = ValidatedLocation;
+	LastRelayedYaw = ClientYaw;
+
+	Multicast_SendMovement(ValidatedLocation, TimeStamp, FMath::Clamp(ClientForward, -1.0f, 1.0f), ClientYaw);
+}
+
+bool AFGPlayer::GetNetDormancy(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth)
+{
+	// The owning client sends its movement through this actor's channel, it must never go dormant for them.
+	if (InChannel == nullptr || InChannel->Connection == GetNetConnection())
+		return false;
+
+	return NetDormancy == DORM_DormantPartial;
+}
+
+void AFGPlayer::Client_CorrectLocation_Implementation(const FVector& CorrectedLocation)
+{
+	FGNET_TRACE_CORRECTION(this, FVector::Dist(GetActorLocation(), CorrectedLocation));
+	UFGFlightRecorder::RecordCorrection(this, FVector::Dist(GetActorLocation(), CorrectedLocation));
+	MovementComponent->InvalidateFloor();
+	SetActorLocation(CorrectedLocation, false, nullptr, ETeleportType::TeleportPhysics);
+}
+
+EFGServerMoveResult AFGPlayer::ValidateClientMove(FVector& InOutClientLocation, float TimeStamp)
+{
+	if (PlayerSettings == nullptr)
+		return EFGServerMoveResult::Accepted;
+
+	FFGServerMoveValidation& Validation = ServerMoveValidation;
+	const float ServerTime = GetWorld()->GetTimeSeconds();
+	const float MaxSpeed = PlayerSettings->MaxVelocity * PlayerSettings->MovementBudgetTolerance;
+	const float MaxBudget = MaxSpeed * PlayerSettings->MaxMovementBudgetSeconds;
+	const float MaxFallBudget = PlayerSettings->MaxFallSpeed * PlayerSettings->MaxMovementBudgetSeconds;
+
+	if (!Validation.bInitialized)
+	{
+		Validation.LastAcceptedLocation = GetActorLocation();
+		Validation.LastServerTime = ServerTime;
+		Validation.LastClientTimeStamp = TimeStamp;
+		Validation.DistanceBudget = MaxBudget;
+		Validation.FallBudget = MaxFallBudget;
+		Validation.bInitialized = true;
+	}
+	else if (TimeStamp <= Validation.LastClientTimeStamp)
+	{
+		// Unreliable packets can arrive out of order, an old one must not move us back.
+		INC_DWORD_STAT(STAT_FGNet_RejectedMoves);
+		return EFGServerMoveResult::Rejected;
+	}
+
+	// The budgets grow with server time, not the client's time stamps, so a sped up client clock gains nothing.
+	const float ElapsedServerTime = ServerTime - Validation.LastServerTime;
+	Validation.DistanceBudget = FMath::Min(Validation.DistanceBudget + MaxSpeed * ElapsedServerTime, MaxBudget);
+	Validation.FallBudget = FMath::Min(Validation.FallBudget + PlayerSettings->MaxFallSpeed * ElapsedServerTime, MaxFallBudget);
+	Validation.LastServerTime = ServerTime;
+	Validation.LastClientTimeStamp = TimeStamp;
+
+	// Falling up to MaxFallSpeed comes out of its own budget, everything else has to fit in the movement budget.
+	const FVector Delta = InOutClientLocation - Validation.LastAcceptedLocation;
+	const float FallDistance = FMath::Min(FMath::Max(-Delta.Z, 0.0f), Validation.FallBudget);
+	const FVector ChargedDelta(Delta.X, Delta.Y, Delta.Z + FallDistance);
+	const float Distance = ChargedDelta.Size();
+	Validation.FallBudget -= FallDistance;
+
+	EFGServerMoveResult Result = EFGServerMoveResult::Accepted;
+
+	if (Distance > Validation.DistanceBudget)
+	{
+		const float Scale = Validation.DistanceBudget / Distance;
+		InOutClientLocation = Validation.LastAcceptedLocation + ChargedDelta * Scale - FVector(0.0f, 0.0f, FallDistance);
+		Validation.DistanceBudget = 0.0f;
+		Validation.NumClampedMoves++;
+		INC_DWORD_STAT(STAT_FGNet_ClampedMoves);
+		Result = EFGServerMoveResult::Clamped;
+	}
+	else
+	{
+		Validation.DistanceBudget -= Distance;
+	}
+
+	Validation.LastAcceptedLocation = InOutClientLocation;
+	return Result;
 }
 
 void AFGPlayer::AddMovementVelocity(float DeltaTime)
@@ -421,6 +964,6 @@ void AFGPlayer::GetLifetimeReplicatedProps(TArray< FLifetimeProperty >& OutLifet
 	DOREPLIFETIME(AFGPlayer, ReplicatedLocation);
 	DOREPLIFETIME(AFGPlayer, RocketInstances);
 	DOREPLIFETIME(AFGPlayer, ServerNumRockets);
+	DOREPLIFETIME_CONDITION(AFGPlayer, SnapshotEntityId, COND_InitialOnly);
 	//DOREPLIFETIME(AFGPlayer, NumRockets);
 }
-#pragma optimize("", on)
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "GameFrameWork/Pawn.h"
+#include "../Net/FGSendScheduler.h"
+#include "../Containers/FGRingBuffer.h"
 #include "FGPlayer.generated.h"
 
 class UCameraComponent;
@@ -12,9 +14,27 @@ class UFGPlayerSettings;
 class UFGNetDebugWidget;
 class AFGRocket;
 class AFGPickup;
+struct FFGPlayerCosmeticState;
+enum class EFGSignificance : uint8;
+
+enum class EFGServerMoveResult : uint8
+{
+	Accepted,
+	Clamped,
+	Rejected
+};
+
+UENUM(BlueprintType)
+enum class EFGProxyMode : uint8
+{
+	// Remote players re-run the movement input they send and are corrected when too far off.
+	Simulated,
+	// Remote players are placed between buffered snapshots, a fixed delay in the past. No simulation or sweeps.
+	SnapshotInterpolation
+};
 
 UCLASS()
-class FGNET_API AFGPlayer : public APawn
+class FGNET_API AFGPlayer : public APawn, public IFGScheduledSender
 {
 	GENERATED_BODY()
 
@@ -24,19 +44,75 @@ public:
 protected:
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 
+	virtual void PossessedBy(AController* NewController) override;
+	virtual void UnPossessed() override;
+	virtual void OnRep_Controller() override;
+
 	virtual void Tick(float DeltaTime) override;
+	virtual bool GetNetDormancy(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth) override;
+
+	// Tick phases, called by UFGTickManager or from Tick when there is no manager.
+	void TickInput(float DeltaTime);
+	void TickSimulate(float DeltaTime);
+	void TickNetSend(float DeltaTime);
+	void TickCosmetic(float DeltaTime);
+
+	// IFGScheduledSender
+	virtual float GetSendImportance() const override;
+	virtual FVector GetSendLocation() const override;
+	virtual int32 GetEstimatedSendBytes() const override;
+	virtual void ExecuteScheduledSend() override;
+	// IFGScheduledSender
+
+	// Safe to call from worker threads.
+	bool ComputeCosmetic(float DeltaTime, float TimeSeconds, FFGPlayerCosmeticState& OutState) const;
+	void ApplyCosmetic(const FFGPlayerCosmeticState& State);
 
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
 	UPROPERTY(EditAnywhere, Category = Settings)
 	UFGPlayerSettings* PlayerSettings = nullptr;
+
+	// How this player is moved on clients where it is a remote proxy.
+	UFUNCTION(BlueprintCallable, Category = Network)
+	void SetProxyMode(EFGProxyMode InProxyMode);
+
+	UFUNCTION(BlueprintPure, Category = Network)
+	EFGProxyMode GetProxyMode() const { return ProxyMode; }
+
+	// Adds a snapshot for SnapshotInterpolation. Time is on the owning client's clock, or the server's for world snapshots.
+	void AddProxySnapshot(float Time, const FVector& Location, float SnapshotYaw);
+
+	// Only clients interpolate, the server keeps simulating remote players so their collision stays current.
+	bool IsSnapshotInterpolated() const;
+
+	// World snapshots from UFGSnapshotSubsystem are sent through the receiving client's own player.
+	UFUNCTION(Client, Unreliable)
+	void Client_ReceiveWorldSnapshot(const TArray<uint8>& SnapshotData, int32 NumBits);
+
+	UFUNCTION(Server, Unreliable)
+	void Server_AckWorldSnapshot(int32 Sequence);
 	
 	UFUNCTION(BlueprintPure)
 	bool IsBraking() const { return bBrake; }
 
+	// Server only. Bots have no controller, UFGBotManager sets their input and they take the locally controlled paths.
+	void SetIsBot(bool bInIsBot);
+	bool IsBot() const { return bIsBot; }
+
+	// The local player, or a bot on the server.
+	bool IsLocallySimulated() const { return bIsBot || IsLocallyControlled(); }
+
+	void SetInput(float InForward, float InTurn, bool bInBrake);
+
+	// Client, set by UFGSignificanceManager for remote proxies.
+	void SetSignificance(EFGSignificance InSignificance);
+	EFGSignificance GetSignificance() const { return Significance; }
+
 	UFUNCTION(BlueprintPure)
 	int32 GetPing() const;
 
@@ -75,30 +151,71 @@ public:
 	void BP_OnNumRocketsChanged(int32 NewNumRockets);
 
 	int32 GetNumActiveRockets() const;
+
+	AFGRocket* GetFreeRocket() const;
 	
 	void FireRocket();
 
+	// Spawns the whole rocket cache now, or queues it with UFGJoinQueue on servers that have one.
 	void SpawnRockets();
 
+	// Spawns one rocket of the cache, returns true while there are more to spawn.
+	bool SpawnNextRocket();
+
 private:
+	template <typename ElementType>
+	friend class TFGTickList;
+
+	int32 TickListIndex = INDEX_NONE;
+
 	void AddMovementVelocity(float DeltaTime);
 
 	UPROPERTY(Replicated)
 	int32 ServerNumRockets = 0;
 
+	UFUNCTION()
+	void OnRep_SnapshotEntityId();
+
+	// Id in world snapshots, see UFGSnapshotSubsystem.
+	UPROPERTY(ReplicatedUsing = OnRep_SnapshotEntityId)
+	int32 SnapshotEntityId = INDEX_NONE;
+
 	//UPROPERTY(Replicated)
 	int32 NumRockets = 0;
 
 	FVector GetRocketStartLocation() const;
 
-	AFGRocket* GetFreeRocket() const;
-
 	UFUNCTION(Server, Unreliable)
 	void Server_SendMovement(const FVector& ClientLocation, float TimeStamp, float ClientForward, float ClientYaw);
 
 	UFUNCTION(NetMulticast, Unreliable)
 	void Multicast_SendMovement(const FVector& InClientLocation, float TimeStamp, float ClientForward, float ClientYaw);
 
+	UFUNCTION(Client, Unreliable)
+	void Client_CorrectLocation(const FVector& CorrectedLocation);
+
+	// What the server knows about this client's movement. No allocations, checked for every movement packet.
+	struct FFGServerMoveValidation
+	{
+		FVector LastAcceptedLocation = FVector::ZeroVector;
+		float LastServerTime = 0.0f;
+		float LastClientTimeStamp = 0.0f;
+		float DistanceBudget = 0.0f;
+		float FallBudget = 0.0f;
+		uint16 NumClampedMoves = 0;
+		uint16 NumRejectedPickups = 0;
+		bool bInitialized = false;
+	};
+
+	FFGServerMoveValidation ServerMoveValidation;
+
+	// Server, what was last relayed to remotes, used to put stationary players to sleep.
+	FVector LastRelayedLocation = FVector::ZeroVector;
+	float LastRelayedYaw = 0.0f;
+	float StationarySince = 0.0f;
+
+	EFGServerMoveResult ValidateClientMove(FVector& InOutClientLocation, float TimeStamp);
+
 	UFUNCTION(Server, Reliable)
 	void Server_FireRocket(AFGRocket* NewRocket, const FVector& RocketSTartLocation, const FRotator& RocketFacignRotation);
 
@@ -152,6 +269,12 @@ private:
 	float Yaw = 0.0f;
 	
 	bool bBrake = false;
+	bool bIsBot = false;
+
+	EFGSignificance Significance{};
+	// Simulation time skipped by lower significance, caught up on the next simulated frame.
+	float SkippedSimulateTime = 0.0f;
+	int32 NumSkippedSimulateFrames = 0;
 
 	float ClientTimeStamp = 0.0f;
 	float ServerTimeStamp = 0.0f;
@@ -160,6 +283,24 @@ private:
 	UPROPERTY(EditAnywhere)
 	bool bPerformNetworkSmoothing = true;
 
+	UPROPERTY(EditAnywhere, Category = Network)
+	EFGProxyMode ProxyMode = EFGProxyMode::Simulated;
+
+	struct FFGProxySnapshot
+	{
+		float Time;
+		FVector Location;
+		float Yaw;
+	};
+
+	TFGRingBuffer<FFGProxySnapshot, 32> ProxySnapshots;
+	float ProxyRenderTime = 0.0f;
+
+	void TickSnapshotInterpolation(float DeltaTime);
+
+	// Updated on the game thread so the cosmetic phase does not have to ask who controls us.
+	bool bApplyMeshSmoothing = false;
+
 	FVector OriginalMeshOffset = FVector::ZeroVector;
 
 	UPROPERTY(VisibleDefaultsOnly, Category = Collision)
@@ -25,4 +25,32 @@ public:
 
 	UPROPERTY(EditAnywhere, Category = Fire, meta = (ClampMin = 0.0))
 	float FireCooldown = 0.15f;
-};
\ No newline at end of file
+
+	// How much faster than MaxVelocity the server lets a client move before clamping it.
+	UPROPERTY(EditAnywhere, Category = "Server Validation", meta = (ClampMin = 1.0))
+	float MovementBudgetTolerance = 1.25f;
+
+	// How many seconds of unused movement a client can bank, covers packets arriving in bursts.
+	UPROPERTY(EditAnywhere, Category = "Server Validation", meta = (ClampMin = 0.0))
+	float MaxMovementBudgetSeconds = 0.5f;
+
+	// Fastest fall the server accepts without charging it to the movement budget.
+	UPROPERTY(EditAnywhere, Category = "Server Validation", meta = (ClampMin = 0.0))
+	float MaxFallSpeed = 4000.0f;
+
+	// Pickups further away than this from the server's view of the player are rejected.
+	UPROPERTY(EditAnywhere, Category = "Server Validation", meta = (ClampMin = 0.0))
+	float MaxPickupDistance = 600.0f;
+
+	// How long a player has to stand still before the server stops relaying its movement and lets it go dormant.
+	UPROPERTY(EditAnywhere, Category = Network, meta = (ClampMin = 0.0))
+	float NetDormancyDelay = 1.0f;
+
+	// Snapshot interpolated proxies are rendered this far behind the newest snapshot.
+	UPROPERTY(EditAnywhere, Category = "Proxy Interpolation", meta = (ClampMin = 0.0))
+	float ProxyInterpolationDelay = 0.1f;
+
+	// How long a snapshot interpolated proxy keeps moving past its newest snapshot before it stops.
+	UPROPERTY(EditAnywhere, Category = "Proxy Interpolation", meta = (ClampMin = 0.0))
+	float ProxyMaxExtrapolationTime = 0.25f;
+};
@@ -0,0 +1,139 @@
+#include "FGSignificanceManager.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "FGTickManager.h"
+#include "../Player/FGPlayer.h"
+#include "../FGRocket.h"
+#include "../FGNetStats.h"
+
+static TAutoConsoleVariable<int32> CVarSignificanceEnabled(
+	TEXT("FGNet.Significance.Enabled"),
+	1,
+	TEXT("Simulate small, far away and off screen proxies less often on clients. 0 puts everything back to High."));
+
+static TAutoConsoleVariable<float> CVarSignificanceUpdateRate(
+	TEXT("FGNet.Significance.UpdateRate"),
+	5.0f,
+	TEXT("How many times per second proxies are scored."));
+
+static TAutoConsoleVariable<float> CVarSignificanceMediumScreenSize(
+	TEXT("FGNet.Significance.MediumScreenSize"),
+	0.05f,
+	TEXT("Proxies smaller than this fraction of the screen are Medium significance."));
+
+static TAutoConsoleVariable<float> CVarSignificanceLowScreenSize(
+	TEXT("FGNet.Significance.LowScreenSize"),
+	0.015f,
+	TEXT("Proxies smaller than this fraction of the screen are Low significance."));
+
+static TAutoConsoleVariable<float> CVarSignificanceOffscreenScale(
+	TEXT("FGNet.Significance.OffscreenScale"),
+	0.25f,
+	TEXT("Screen size multiplier for proxies that are outside the view or were not rendered recently."));
+
+UFGSignificanceManager* UFGSignificanceManager::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject != nullptr ? WorldContextObject->GetWorld() : nullptr;
+	return World != nullptr ? World->GetSubsystem<UFGSignificanceManager>() : nullptr;
+}
+
+void UFGSignificanceManager::Tick(float DeltaTime)
+{
+	UpdateTimer -= DeltaTime;
+	if (UpdateTimer > 0.0f)
+		return;
+
+	UpdateTimer = FMath::Max(UpdateTimer + 1.0f / FMath::Max(CVarSignificanceUpdateRate.GetValueOnGameThread(), 1.0f), 0.0f);
+
+	const UFGTickManager* TickManager = UFGTickManager::Get(this);
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (TickManager == nullptr || PlayerController == nullptr)
+		return;
+
+	FView View;
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(View.Location, ViewRotation);
+	View.Direction = ViewRotation.Vector();
+
+	const float FOV = PlayerController->PlayerCameraManager != nullptr ? PlayerController->PlayerCameraManager->GetFOVAngle() : 90.0f;
+	View.CosHalfFOV = FMath::Cos(FMath::DegreesToRadians(FOV * 0.5f));
+	View.TanHalfFOV = FMath::Tan(FMath::DegreesToRadians(FOV * 0.5f));
+
+	const APawn* LocalPawn = PlayerController->GetPawn();
+	const bool bEnabled = CVarSignificanceEnabled.GetValueOnGameThread() != 0;
+	uint32 NumReduced = 0;
+
+	for (AFGPlayer* Player : TickManager->GetPlayers())
+	{
+		if (Player == nullptr || Player->IsLocallySimulated())
+			continue;
+
+		const EFGSignificance Significance = bEnabled ? Evaluate(View, Player) : EFGSignificance::High;
+		Player->SetSignificance(Significance);
+		NumReduced += Significance != EFGSignificance::High ? 1 : 0;
+	}
+
+	for (AFGRocket* Rocket : TickManager->GetRockets())
+	{
+		if (Rocket == nullptr)
+			continue;
+
+		// Our own rockets are what we aim with, never cut corners on those.
+		const EFGSignificance Significance = bEnabled && Rocket->GetOwner() != LocalPawn ? Evaluate(View, Rocket) : EFGSignificance::High;
+		Rocket->SetSignificance(Significance);
+		NumReduced += Significance != EFGSignificance::High ? 1 : 0;
+	}
+
+	SET_DWORD_STAT(STAT_FGNet_ReducedSignificance, NumReduced);
+}
+
+EFGSignificance UFGSignificanceManager::Evaluate(const FView& View, const AActor* Actor)
+{
+	const FVector ToActor = Actor->GetActorLocation() - View.Location;
+	const float Distance = ToActor.Size();
+
+	float Radius = 50.0f;
+	if (const USceneComponent* RootComponent = Actor->GetRootComponent())
+	{
+		Radius = FMath::Max(RootComponent->Bounds.SphereRadius, 1.0f);
+	}
+
+	// Fraction of half the screen the actor's bounds cover.
+	float ScreenSize = Radius / FMath::Max(Distance * View.TanHalfFOV, 1.0f);
+
+	const bool bInView = Distance <= Radius || FVector::DotProduct(ToActor / Distance, View.Direction) >= View.CosHalfFOV;
+	if (!bInView || !Actor->WasRecentlyRendered(0.25f))
+	{
+		ScreenSize *= CVarSignificanceOffscreenScale.GetValueOnGameThread();
+	}
+
+	if (ScreenSize < CVarSignificanceLowScreenSize.GetValueOnGameThread())
+		return EFGSignificance::Low;
+
+	if (ScreenSize < CVarSignificanceMediumScreenSize.GetValueOnGameThread())
+		return EFGSignificance::Medium;
+
+	return EFGSignificance::High;
+}
+
+bool UFGSignificanceManager::IsTickable() const
+{
+	return GetWorld()->GetNetMode() == NM_Client;
+}
+
+ETickableTickType UFGSignificanceManager::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+UWorld* UFGSignificanceManager::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+TStatId UFGSignificanceManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFGSignificanceManager, STATGROUP_Tickables);
+}
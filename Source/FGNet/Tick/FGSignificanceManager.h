@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "FGSignificanceManager.generated.h"
+
+class AActor;
+
+// How much a remote proxy matters to the local player, from the significance manager.
+enum class EFGSignificance : uint8
+{
+	// Full rate simulation, sweeps, smoothing and rocket traces.
+	High,
+	// Simulated every other frame without smoothing, rockets trace at half rate.
+	Medium,
+	// Simulated every fourth frame without sweeps or smoothing, rockets trace at a quarter rate.
+	Low
+};
+
+/*
+ * Client side, scores remote players and rockets by how large they are on screen and whether they were rendered
+ * recently, a few times per second. Proxies that are small, far away or off screen are simulated less often and
+ * cheaper, see EFGSignificance. The local player and its own rockets are always High.
+ */
+UCLASS()
+class FGNET_API UFGSignificanceManager : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	static UFGSignificanceManager* Get(const UObject* WorldContextObject);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+	// FTickableGameObject
+
+private:
+	struct FView
+	{
+		FVector Location;
+		FVector Direction;
+		float CosHalfFOV;
+		float TanHalfFOV;
+	};
+
+	static EFGSignificance Evaluate(const FView& View, const AActor* Actor);
+
+	float UpdateTimer = 0.0f;
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+ * Dense array of objects ticked by a manager.
+ * Elements store their own index in TickListIndex so removal is a swap, removals made while the list is
+ * being iterated are deferred until the outermost iteration is done.
+ */
+template <typename ElementType>
+class TFGTickList
+{
+public:
+	void Add(ElementType* Element)
+	{
+		check(Element != nullptr);
+
+		if (Element->TickListIndex != INDEX_NONE)
+			return;
+
+		Element->TickListIndex = Elements.Add(Element);
+	}
+
+	void Remove(ElementType* Element)
+	{
+		check(Element != nullptr);
+
+		const int32 Index = Element->TickListIndex;
+		if (Index == INDEX_NONE)
+			return;
+
+		check(Elements[Index] == Element);
+		Element->TickListIndex = INDEX_NONE;
+
+		if (IterationDepth > 0)
+		{
+			Elements[Index] = nullptr;
+			bHasPendingRemovals = true;
+		}
+		else
+		{
+			RemoveAtSwap(Index);
+		}
+	}
+
+	void Empty()
+	{
+		check(IterationDepth == 0);
+
+		for (ElementType* Element : Elements)
+		{
+			if (Element != nullptr)
+				Element->TickListIndex = INDEX_NONE;
+		}
+
+		Elements.Empty();
+		bHasPendingRemovals = false;
+	}
+
+	bool Contains(const ElementType* Element) const { return Element->TickListIndex != INDEX_NONE; }
+
+	int32 Num() const { return Elements.Num(); }
+
+	// Elements added while iterating are picked up on the next iteration.
+	template <typename FunctorType>
+	void ForEach(FunctorType&& Functor)
+	{
+		BeginIteration();
+
+		const int32 NumElements = Elements.Num();
+		for (int32 Index = 0; Index < NumElements; ++Index)
+		{
+			if (ElementType* Element = Elements[Index])
+				Functor(*Element);
+		}
+
+		EndIteration();
+	}
+
+	// Raw access for parallel work. Entries can be null between BeginIteration and EndIteration.
+	TArrayView<ElementType* const> GetElements() const { return TArrayView<ElementType* const>(Elements); }
+
+	void BeginIteration() { ++IterationDepth; }
+
+	void EndIteration()
+	{
+		check(IterationDepth > 0);
+		--IterationDepth;
+
+		if (IterationDepth == 0 && bHasPendingRemovals)
+			Compact();
+	}
+
+private:
+	void RemoveAtSwap(int32 Index)
+	{
+		Elements.RemoveAtSwap(Index, 1, false);
+
+		if (Elements.IsValidIndex(Index) && Elements[Index] != nullptr)
+			Elements[Index]->TickListIndex = Index;
+	}
+
+	void Compact()
+	{
+		// Walking backwards means whatever gets swapped in has already been checked.
+		for (int32 Index = Elements.Num() - 1; Index >= 0; --Index)
+		{
+			if (Elements[Index] == nullptr)
+				RemoveAtSwap(Index);
+		}
+
+		bHasPendingRemovals = false;
+	}
+
+	TArray<ElementType*> Elements;
+	int32 IterationDepth = 0;
+	bool bHasPendingRemovals = false;
+};
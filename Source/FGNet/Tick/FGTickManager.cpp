@@ -0,0 +1,234 @@
+#include "FGTickManager.h"
+#include "../Player/FGPlayer.h"
+#include "../FGRocket.h"
+#include "../FGPickup.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "GameFramework/PlayerController.h"
+#include "Async/ParallelFor.h"
+#include "Misc/App.h"
+#include "../FGNetStats.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarTickManagerParallelCosmetic(
+	TEXT("FGNet.TickManager.ParallelCosmetic"),
+	1,
+	TEXT("Compute cosmetic updates for players and pickups on worker threads."));
+
+static TAutoConsoleVariable<int32> CVarTickManagerParallelCosmeticMinBatch(
+	TEXT("FGNet.TickManager.ParallelCosmeticMinBatch"),
+	64,
+	TEXT("Smallest number of objects in a group before cosmetic updates go wide."));
+
+namespace
+{
+	template <typename ElementType, typename StateType>
+	void TickCosmeticGroup(TFGTickList<ElementType>& List, TArray<StateType>& States, TArray<bool>& Valid, float DeltaTime, float TimeSeconds, bool bAllowParallel)
+	{
+		const int32 NumElements = List.Num();
+		if (NumElements == 0)
+			return;
+
+		if (!bAllowParallel || NumElements < CVarTickManagerParallelCosmeticMinBatch.GetValueOnGameThread())
+		{
+			List.ForEach([DeltaTime](ElementType& Element) { Element.TickCosmetic(DeltaTime); });
+			return;
+		}
+
+		States.SetNumUninitialized(NumElements, false);
+		Valid.SetNumUninitialized(NumElements, false);
+
+		// Only the math goes wide, touching components has to happen back on the game thread.
+		List.BeginIteration();
+		TArrayView<ElementType* const> Elements = List.GetElements();
+		ParallelFor(NumElements, [&](int32 Index)
+		{
+			const ElementType* Element = Elements[Index];
+			Valid[Index] = Element != nullptr && Element->ComputeCosmetic(DeltaTime, TimeSeconds, States[Index]);
+		});
+
+		for (int32 Index = 0; Index < NumElements; ++Index)
+		{
+			if (Valid[Index])
+				Elements[Index]->ApplyCosmetic(States[Index]);
+		}
+		List.EndIteration();
+	}
+}
+
+void FFGTickManagerTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Manager != nullptr)
+		Manager->TickPhase(Phase, DeltaTime);
+}
+
+FString FFGTickManagerTickFunction::DiagnosticMessage()
+{
+	return FString::Printf(TEXT("UFGTickManager[%d]"), static_cast<int32>(Phase));
+}
+
+void UFGTickManager::Deinitialize()
+{
+	if (bTickFunctionsRegistered)
+	{
+		for (FFGTickManagerTickFunction& TickFunction : TickFunctions)
+		{
+			TickFunction.UnRegisterTickFunction();
+		}
+
+		bTickFunctionsRegistered = false;
+	}
+
+	InputPrerequisites.Empty();
+
+	Super::Deinitialize();
+}
+
+UFGTickManager* UFGTickManager::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject != nullptr ? WorldContextObject->GetWorld() : nullptr;
+	return World != nullptr ? World->GetSubsystem<UFGTickManager>() : nullptr;
+}
+
+void UFGTickManager::RegisterPlayer(AFGPlayer* Player)
+{
+	RegisterTickFunctions();
+	Players.Add(Player);
+	UpdateInputPrerequisite(Player);
+}
+
+void UFGTickManager::UnregisterPlayer(AFGPlayer* Player)
+{
+	RemoveInputPrerequisite(Player);
+	Players.Remove(Player);
+}
+
+void UFGTickManager::UpdateInputPrerequisite(AFGPlayer* Player)
+{
+	if (!bTickFunctionsRegistered)
+		return;
+
+	APlayerController* Controller = Player->IsLocallyControlled() ? Cast<APlayerController>(Player->GetController()) : nullptr;
+
+	const FInputPrerequisite* Existing = InputPrerequisites.FindByPredicate([Player](const FInputPrerequisite& Prerequisite) { return Prerequisite.Player == Player; });
+	if (Existing != nullptr && Existing->Controller.Get() == Controller)
+		return;
+
+	RemoveInputPrerequisite(Player);
+
+	if (Controller == nullptr)
+		return;
+
+	TickFunctions[static_cast<int32>(EFGTickPhase::Input)].AddPrerequisite(Controller, Controller->PrimaryActorTick);
+	InputPrerequisites.Add({ Player, Controller });
+}
+
+void UFGTickManager::RemoveInputPrerequisite(AFGPlayer* Player)
+{
+	const int32 Index = InputPrerequisites.IndexOfByPredicate([Player](const FInputPrerequisite& Prerequisite) { return Prerequisite.Player == Player; });
+	if (Index == INDEX_NONE)
+		return;
+
+	// A destroyed controller has already unregistered its tick function, stale prerequisites are skipped by the engine.
+	if (AController* Controller = InputPrerequisites[Index].Controller.Get())
+	{
+		TickFunctions[static_cast<int32>(EFGTickPhase::Input)].RemovePrerequisite(Controller, Controller->PrimaryActorTick);
+	}
+
+	InputPrerequisites.RemoveAtSwap(Index, 1, false);
+}
+
+void UFGTickManager::RegisterRocket(AFGRocket* Rocket)
+{
+	RegisterTickFunctions();
+	Rockets.Add(Rocket);
+}
+
+void UFGTickManager::UnregisterRocket(AFGRocket* Rocket)
+{
+	Rockets.Remove(Rocket);
+}
+
+void UFGTickManager::RegisterPickup(AFGPickup* Pickup)
+{
+	RegisterTickFunctions();
+	Pickups.Add(Pickup);
+}
+
+void UFGTickManager::UnregisterPickup(AFGPickup* Pickup)
+{
+	Pickups.Remove(Pickup);
+}
+
+void UFGTickManager::TickPhase(EFGTickPhase Phase, float DeltaTime)
+{
+	FGNET_SCOPE_CYCLE_COUNTER(STAT_FGNet_TickPhase);
+
+	const uint32 StartCycles = FPlatformTime::Cycles();
+
+	switch (Phase)
+	{
+	case EFGTickPhase::Input:
+		Players.ForEach([DeltaTime](AFGPlayer& Player) { Player.TickInput(DeltaTime); });
+		break;
+	case EFGTickPhase::Simulate:
+		Players.ForEach([DeltaTime](AFGPlayer& Player) { Player.TickSimulate(DeltaTime); });
+		Rockets.ForEach([DeltaTime](AFGRocket& Rocket) { Rocket.TickSimulate(DeltaTime); });
+		break;
+	case EFGTickPhase::NetSend:
+		Players.ForEach([DeltaTime](AFGPlayer& Player) { Player.TickNetSend(DeltaTime); });
+		break;
+	case EFGTickPhase::Cosmetic:
+#if FGNET_WITH_COSMETICS
+		TickCosmetic(DeltaTime);
+#endif
+		break;
+	default:
+		break;
+	}
+
+	PhaseCycles[static_cast<int32>(Phase)] = FPlatformTime::Cycles() - StartCycles;
+}
+
+void UFGTickManager::RegisterTickFunctions()
+{
+	if (bTickFunctionsRegistered)
+		return;
+
+	UWorld* World = GetWorld();
+	if (World == nullptr || World->PersistentLevel == nullptr)
+		return;
+
+	static const ETickingGroup PhaseTickGroups[] = { TG_PrePhysics, TG_PrePhysics, TG_PostPhysics, TG_PostUpdateWork };
+	static_assert(UE_ARRAY_COUNT(PhaseTickGroups) == static_cast<int32>(EFGTickPhase::Num), "Every tick phase needs a tick group");
+
+	for (int32 Index = 0; Index < static_cast<int32>(EFGTickPhase::Num); ++Index)
+	{
+		FFGTickManagerTickFunction& TickFunction = TickFunctions[Index];
+		TickFunction.Manager = this;
+		TickFunction.Phase = static_cast<EFGTickPhase>(Index);
+		TickFunction.bCanEverTick = true;
+		TickFunction.bStartWithTickEnabled = true;
+		TickFunction.bTickEvenWhenPaused = false;
+		TickFunction.TickGroup = PhaseTickGroups[Index];
+
+		// Phases run in order even when they share a tick group.
+		if (Index > 0)
+			TickFunction.AddPrerequisite(this, TickFunctions[Index - 1]);
+
+		TickFunction.RegisterTickFunction(World->PersistentLevel);
+	}
+
+	bTickFunctionsRegistered = true;
+}
+
+void UFGTickManager::TickCosmetic(float DeltaTime)
+{
+	Rockets.ForEach([DeltaTime](AFGRocket& Rocket) { Rocket.TickCosmetic(DeltaTime); });
+
+	const bool bAllowParallel = CVarTickManagerParallelCosmetic.GetValueOnGameThread() != 0 && FApp::ShouldUseThreadingForPerformance();
+	const float TimeSeconds = GetWorld()->GetTimeSeconds();
+
+	TickCosmeticGroup(Players, PlayerCosmeticStates, CosmeticStateValid, DeltaTime, TimeSeconds, bAllowParallel);
+	TickCosmeticGroup(Pickups, PickupCosmeticStates, CosmeticStateValid, DeltaTime, TimeSeconds, bAllowParallel);
+}
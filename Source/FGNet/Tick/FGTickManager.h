@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "FGTickList.h"
+#include "FGTickManager.generated.h"
+
+class AController;
+class AFGPlayer;
+class AFGRocket;
+class AFGPickup;
+class UFGTickManager;
+
+UENUM()
+enum class EFGTickPhase : uint8
+{
+	Input,
+	Simulate,
+	NetSend,
+	Cosmetic,
+	Num UMETA(Hidden)
+};
+
+// Cosmetic updates are computed on worker threads and applied on the game thread.
+struct FFGPlayerCosmeticState
+{
+	FVector MeshRelativeLocation;
+};
+
+struct FFGPickupCosmeticState
+{
+	FVector MeshRelativeLocation;
+	FRotator MeshRelativeRotation;
+};
+
+USTRUCT()
+struct FFGTickManagerTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UFGTickManager* Manager = nullptr;
+	EFGTickPhase Phase = EFGTickPhase::Input;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FFGTickManagerTickFunction> : public TStructOpsTypeTraitsBase2<FFGTickManagerTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/*
+ * Ticks every registered player, rocket and pickup from one tick function per phase instead of one actor tick each.
+ * Actors register in BeginPlay and disable their own actor tick, Tick on the actors is still there for worlds without the manager.
+ */
+UCLASS()
+class FGNET_API UFGTickManager : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+
+	static UFGTickManager* Get(const UObject* WorldContextObject);
+
+	void RegisterPlayer(AFGPlayer* Player);
+	void UnregisterPlayer(AFGPlayer* Player);
+
+	// Input is processed in the player controller's tick, a locally controlled player's Input phase has to wait for it.
+	// Call when the player's controller changes.
+	void UpdateInputPrerequisite(AFGPlayer* Player);
+
+	void RegisterRocket(AFGRocket* Rocket);
+	void UnregisterRocket(AFGRocket* Rocket);
+
+	void RegisterPickup(AFGPickup* Pickup);
+	void UnregisterPickup(AFGPickup* Pickup);
+
+	void TickPhase(EFGTickPhase Phase, float DeltaTime);
+
+	int32 GetNumPlayers() const { return Players.Num(); }
+	int32 GetNumRockets() const { return Rockets.Num(); }
+	int32 GetNumPickups() const { return Pickups.Num(); }
+
+	// Entries can be null while a phase is ticking.
+	TArrayView<AFGPlayer* const> GetPlayers() const { return Players.GetElements(); }
+	TArrayView<AFGRocket* const> GetRockets() const { return Rockets.GetElements(); }
+
+	// How long the phase took the last time it ran.
+	uint32 GetPhaseCycles(EFGTickPhase Phase) const { return PhaseCycles[static_cast<int32>(Phase)]; }
+
+private:
+	void RegisterTickFunctions();
+	void RemoveInputPrerequisite(AFGPlayer* Player);
+	void TickCosmetic(float DeltaTime);
+
+	struct FInputPrerequisite
+	{
+		AFGPlayer* Player;
+		TWeakObjectPtr<AController> Controller;
+	};
+
+	FFGTickManagerTickFunction TickFunctions[static_cast<int32>(EFGTickPhase::Num)];
+
+	TFGTickList<AFGPlayer> Players;
+	TFGTickList<AFGRocket> Rockets;
+	TFGTickList<AFGPickup> Pickups;
+
+	TArray<FFGPlayerCosmeticState> PlayerCosmeticStates;
+	TArray<FFGPickupCosmeticState> PickupCosmeticStates;
+	TArray<bool> CosmeticStateValid;
+
+	// Controllers the Input phase waits for, the pawn's own actor tick used to get this from AddPawnTickDependency.
+	TArray<FInputPrerequisite> InputPrerequisites;
+
+	uint32 PhaseCycles[static_cast<int32>(EFGTickPhase::Num)] = {};
+
+	bool bTickFunctionsRegistered = false;
+};